@@ -0,0 +1,79 @@
+# Times the Python speech extraction on the file and segments of silero-vad-extract.cpp, for
+# comparison with SpeechExtractor:
+#   split_pydub   : split_wav_by_timestamps() from my-info/split_wav_based_on_vad.py (pydub)
+#   collect_torch : read_audio() + collect_chunks() + save_audio() from utils_vad.py
+#   drop_torch    : read_audio() + drop_chunks() + save_audio() from utils_vad.py
+# Tools whose packages are missing are reported as null. Output is JSON.
+#
+# Usage: ./extract --seconds 600 --timestamps ts.json
+#        python extract_bench.py silero_vad_extract_src.wav ts.json [out_dir]
+import contextlib
+import io
+import json
+import os
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(HERE, '..', '..', 'src'))
+sys.path.insert(0, os.path.join(HERE, '..', '..', 'my-info'))
+SAMPLING_RATE = 16000
+
+
+def best_of(runs, f):
+    best = float('inf')
+    for _ in range(runs):
+        t = time.perf_counter()
+        f()
+        best = min(best, time.perf_counter() - t)
+    return best
+
+
+def bench_pydub(wav_path, tss, out_dir, runs):
+    try:
+        from split_wav_based_on_vad import split_wav_by_timestamps
+    except ImportError:
+        return None
+    seconds = [{'start': t['start'] / SAMPLING_RATE, 'end': t['end'] / SAMPLING_RATE} for t in tss]
+
+    def run():
+        with contextlib.redirect_stdout(io.StringIO()):
+            split_wav_by_timestamps(wav_path, seconds, out_dir, 'py')
+    return best_of(runs, run)
+
+
+def bench_torch(wav_path, tss, out_dir, runs):
+    try:
+        from silero_vad.utils_vad import collect_chunks, drop_chunks, read_audio, save_audio
+    except ImportError:
+        return None, None
+    # Timestamps in samples: the seconds path of collect_chunks() rounds to whole seconds.
+    collect = best_of(runs, lambda: save_audio(os.path.join(out_dir, 'py_speech.wav'),
+                                               collect_chunks(tss, read_audio(wav_path, SAMPLING_RATE)),
+                                               SAMPLING_RATE))
+    drop = best_of(runs, lambda: save_audio(os.path.join(out_dir, 'py_silence.wav'),
+                                            drop_chunks(tss, read_audio(wav_path, SAMPLING_RATE)),
+                                            SAMPLING_RATE))
+    return collect, drop
+
+
+if __name__ == '__main__':
+    wav_path = sys.argv[1]
+    with open(sys.argv[2]) as f:
+        tss = json.load(f)
+    runs = 3
+    with tempfile.TemporaryDirectory(dir=sys.argv[3] if len(sys.argv) > 3 else None) as out_dir:
+        split = bench_pydub(wav_path, tss, out_dir, runs)
+        collect, drop = bench_torch(wav_path, tss, out_dir, runs)
+
+    # Speech payload in MB (16-bit mono at 16 kHz), for MB/s comparable to the C++ report.
+    speech_mb = sum(t['end'] - t['start'] for t in tss) * 2 / 1e6
+
+    def result(seconds):
+        return None if seconds is None else {'seconds': round(seconds, 4), 'mb_per_sec': round(speech_mb / seconds, 1)}
+    print(json.dumps({'segments': len(tss), 'speech_mb': round(speech_mb, 2),
+                      'results': {'split_pydub': result(split),
+                                  'collect_torch': result(collect),
+                                  'drop_torch': None if drop is None else {'seconds': round(drop, 4)}}},
+                     indent=2))
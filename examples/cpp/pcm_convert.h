@@ -0,0 +1,440 @@
+// PCM to float conversion kernels with runtime CPU dispatch.
+//
+// Every kernel converts n contiguous samples to float in [-1, 1):
+//   u8  : (x - 128) / 128          (8-bit WAV is unsigned)
+//   s16 : x / 32768
+//   s24 : x / 8388608              (packed, 3 bytes per sample, little endian)
+//   s32 : x / 2147483648
+//   f32 : copied as is
+// All scale factors are powers of two, so the SIMD variants are bit-exact with
+// the scalar reference. Inputs may be unaligned (e.g. a memory-mapped data chunk).
+// This is the only copy: the LibTorch example's wav.h includes it from here.
+//
+// Deinterleave() splits interleaved float frames into one buffer per channel;
+// stereo (the common split-channel call recording) has SIMD kernels.
+//
+// AVX2 and SSE4.1 variants are compiled with function target attributes, so no
+// -mavx2 is needed; the best one supported by the CPU is picked on first use.
+
+#ifndef FRONTEND_PCM_CONVERT_H_
+#define FRONTEND_PCM_CONVERT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PCM_CONVERT_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PCM_CONVERT_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(PCM_CONVERT_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PCM_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PCM_TARGET(isa)
+#endif
+
+namespace pcm {
+
+typedef void (*ConvertFn)(const void* in, float* out, size_t n);
+// Splits n interleaved stereo frames (L R L R ...) into ch0 and ch1.
+typedef void (*StereoFn)(const float* in, float* ch0, float* ch1, size_t n);
+
+struct Kernels {
+  const char* name;
+  ConvertFn u8;
+  ConvertFn s16;
+  ConvertFn s24;
+  ConvertFn s32;
+  ConvertFn f32;
+  StereoFn stereo;
+};
+
+// ----- Scalar reference -----
+
+inline void U8ToFloatScalar(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  for (size_t i = 0; i < n; ++i)
+    out[i] = static_cast<float>(static_cast<int>(p[i]) - 128) * (1.0f / 128);
+}
+
+inline void S16ToFloatScalar(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  for (size_t i = 0; i < n; ++i) {
+    int16_t v;
+    memcpy(&v, p + 2 * i, sizeof(v));
+    out[i] = static_cast<float>(v) * (1.0f / 32768);
+  }
+}
+
+inline void S24ToFloatScalar(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  for (size_t i = 0; i < n; ++i, p += 3) {
+    int32_t v = static_cast<int32_t>(static_cast<uint32_t>(p[0]) << 8 |
+                                     static_cast<uint32_t>(p[1]) << 16 |
+                                     static_cast<uint32_t>(p[2]) << 24) >> 8;
+    out[i] = static_cast<float>(v) * (1.0f / 8388608);
+  }
+}
+
+inline void S32ToFloatScalar(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  for (size_t i = 0; i < n; ++i) {
+    int32_t v;
+    memcpy(&v, p + 4 * i, sizeof(v));
+    out[i] = static_cast<float>(v) * (1.0f / 2147483648.0f);
+  }
+}
+
+inline void F32ToFloatScalar(const void* in, float* out, size_t n) {
+  memcpy(out, in, n * sizeof(float));
+}
+
+inline void StereoScalar(const float* in, float* ch0, float* ch1, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    ch0[i] = in[2 * i];
+    ch1[i] = in[2 * i + 1];
+  }
+}
+
+inline const Kernels& ScalarKernels() {
+  static const Kernels k = {"scalar", U8ToFloatScalar, S16ToFloatScalar,
+                            S24ToFloatScalar, S32ToFloatScalar,
+                            F32ToFloatScalar, StereoScalar};
+  return k;
+}
+
+#ifdef PCM_CONVERT_X86
+
+// ----- SSE4.1 -----
+
+PCM_TARGET("sse4.1")
+inline void U8ToFloatSse41(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  const __m128i bias = _mm_set1_epi32(128);
+  const __m128 scale = _mm_set1_ps(1.0f / 128);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int32_t raw;
+    memcpy(&raw, p + i, sizeof(raw));
+    __m128i v = _mm_sub_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(raw)), bias);
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+  }
+  U8ToFloatScalar(p + i, out + i, n - i);
+}
+
+PCM_TARGET("sse4.1")
+inline void S16ToFloatSse41(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  const __m128 scale = _mm_set1_ps(1.0f / 32768);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2 * i));
+    __m128i lo = _mm_cvtepi16_epi32(v);
+    __m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(v, 8));
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+  S16ToFloatScalar(p + 2 * i, out + i, n - i);
+}
+
+PCM_TARGET("sse4.1")
+inline void S24ToFloatSse41(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  // Move the 3 bytes of each sample to the top of a 32-bit lane, then shift
+  // arithmetically to sign-extend.
+  const __m128i shuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5,
+                                        -1, 6, 7, 8, -1, 9, 10, 11);
+  const __m128 scale = _mm_set1_ps(1.0f / 8388608);
+  size_t i = 0;
+  for (; i + 6 <= n; i += 4) {  // 16-byte load, 12 bytes used
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 3 * i));
+    v = _mm_srai_epi32(_mm_shuffle_epi8(v, shuffle), 8);
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+  }
+  S24ToFloatScalar(p + 3 * i, out + i, n - i);
+}
+
+PCM_TARGET("sse4.1")
+inline void S32ToFloatSse41(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  const __m128 scale = _mm_set1_ps(1.0f / 2147483648.0f);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 4 * i));
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+  }
+  S32ToFloatScalar(p + 4 * i, out + i, n - i);
+}
+
+PCM_TARGET("sse4.1")
+inline void StereoSse41(const float* in, float* ch0, float* ch1, size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 a = _mm_loadu_ps(in + 2 * i);      // L0 R0 L1 R1
+    __m128 b = _mm_loadu_ps(in + 2 * i + 4);  // L2 R2 L3 R3
+    _mm_storeu_ps(ch0 + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(ch1 + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+  StereoScalar(in + 2 * i, ch0 + i, ch1 + i, n - i);
+}
+
+// ----- AVX2 -----
+
+PCM_TARGET("avx2")
+inline void U8ToFloatAvx2(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  const __m256i bias = _mm256_set1_epi32(128);
+  const __m256 scale = _mm256_set1_ps(1.0f / 128);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    __m256i lo = _mm256_sub_epi32(_mm256_cvtepu8_epi32(v), bias);
+    __m256i hi = _mm256_sub_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)), bias);
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+    _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+  }
+  U8ToFloatSse41(p + i, out + i, n - i);
+}
+
+PCM_TARGET("avx2")
+inline void S16ToFloatAvx2(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  const __m256 scale = _mm256_set1_ps(1.0f / 32768);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2 * i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2 * i + 16));
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(a)), scale));
+    _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(b)), scale));
+  }
+  S16ToFloatSse41(p + 2 * i, out + i, n - i);
+}
+
+PCM_TARGET("avx2")
+inline void S24ToFloatAvx2(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  const __m256i shuffle = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5,
+                                           -1, 6, 7, 8, -1, 9, 10, 11,
+                                           -1, 0, 1, 2, -1, 3, 4, 5,
+                                           -1, 6, 7, 8, -1, 9, 10, 11);
+  const __m256 scale = _mm256_set1_ps(1.0f / 8388608);
+  size_t i = 0;
+  for (; i + 10 <= n; i += 8) {  // two 16-byte loads 12 bytes apart
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 3 * i));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 3 * i + 12));
+    __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    v = _mm256_srai_epi32(_mm256_shuffle_epi8(v, shuffle), 8);
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+  S24ToFloatSse41(p + 3 * i, out + i, n - i);
+}
+
+PCM_TARGET("avx2")
+inline void S32ToFloatAvx2(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  const __m256 scale = _mm256_set1_ps(1.0f / 2147483648.0f);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 4 * i));
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+  S32ToFloatSse41(p + 4 * i, out + i, n - i);
+}
+
+PCM_TARGET("avx2")
+inline void StereoAvx2(const float* in, float* ch0, float* ch1, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 a = _mm256_loadu_ps(in + 2 * i);      // frames 0-3
+    __m256 b = _mm256_loadu_ps(in + 2 * i + 8);  // frames 4-7
+    __m256 lo = _mm256_permute2f128_ps(a, b, 0x20);  // frames 0-1 | 4-5
+    __m256 hi = _mm256_permute2f128_ps(a, b, 0x31);  // frames 2-3 | 6-7
+    _mm256_storeu_ps(ch0 + i, _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm256_storeu_ps(ch1 + i, _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+  StereoSse41(in + 2 * i, ch0 + i, ch1 + i, n - i);
+}
+
+inline const Kernels& Sse41Kernels() {
+  static const Kernels k = {"sse4.1", U8ToFloatSse41, S16ToFloatSse41,
+                            S24ToFloatSse41, S32ToFloatSse41,
+                            F32ToFloatScalar, StereoSse41};
+  return k;
+}
+
+inline const Kernels& Avx2Kernels() {
+  static const Kernels k = {"avx2", U8ToFloatAvx2, S16ToFloatAvx2,
+                            S24ToFloatAvx2, S32ToFloatAvx2, F32ToFloatScalar,
+                            StereoAvx2};
+  return k;
+}
+
+inline bool CpuHasSse41() {
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 19)) != 0;
+#else
+  return __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+inline bool CpuHasAvx2() {
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) return false;
+  __cpuid(info, 1);
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  if (!osxsave || (_xgetbv(0) & 6) != 6) return false;  // OS saves YMM state
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif  // PCM_CONVERT_X86
+
+#ifdef PCM_CONVERT_NEON
+
+// ----- NEON -----
+
+inline void U8ToFloatNeon(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  const int16x8_t bias = vdupq_n_s16(128);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p + i))), bias);
+    vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), 1.0f / 128));
+    vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), 1.0f / 128));
+  }
+  U8ToFloatScalar(p + i, out + i, n - i);
+}
+
+inline void S16ToFloatNeon(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    int16x8_t v = vreinterpretq_s16_u8(vld1q_u8(p + 2 * i));
+    vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), 1.0f / 32768));
+    vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), 1.0f / 32768));
+  }
+  S16ToFloatScalar(p + 2 * i, out + i, n - i);
+}
+
+inline void S24ToFloatNeon(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    uint8x8x3_t b = vld3_u8(p + 3 * i);  // de-interleaves byte 0/1/2 of 8 samples
+    uint16x8_t b0 = vmovl_u8(b.val[0]), b1 = vmovl_u8(b.val[1]), b2 = vmovl_u8(b.val[2]);
+    uint32x4_t lo = vorrq_u32(vorrq_u32(vshlq_n_u32(vmovl_u16(vget_low_u16(b0)), 8),
+                                        vshlq_n_u32(vmovl_u16(vget_low_u16(b1)), 16)),
+                              vshlq_n_u32(vmovl_u16(vget_low_u16(b2)), 24));
+    uint32x4_t hi = vorrq_u32(vorrq_u32(vshlq_n_u32(vmovl_u16(vget_high_u16(b0)), 8),
+                                        vshlq_n_u32(vmovl_u16(vget_high_u16(b1)), 16)),
+                              vshlq_n_u32(vmovl_u16(vget_high_u16(b2)), 24));
+    vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vshrq_n_s32(vreinterpretq_s32_u32(lo), 8)), 1.0f / 8388608));
+    vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vshrq_n_s32(vreinterpretq_s32_u32(hi), 8)), 1.0f / 8388608));
+  }
+  S24ToFloatScalar(p + 3 * i, out + i, n - i);
+}
+
+inline void S32ToFloatNeon(const void* in, float* out, size_t n) {
+  const uint8_t* p = static_cast<const uint8_t*>(in);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int32x4_t v = vreinterpretq_s32_u8(vld1q_u8(p + 4 * i));
+    vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(v), 1.0f / 2147483648.0f));
+  }
+  S32ToFloatScalar(p + 4 * i, out + i, n - i);
+}
+
+inline void StereoNeon(const float* in, float* ch0, float* ch1, size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float32x4x2_t v = vld2q_f32(in + 2 * i);
+    vst1q_f32(ch0 + i, v.val[0]);
+    vst1q_f32(ch1 + i, v.val[1]);
+  }
+  StereoScalar(in + 2 * i, ch0 + i, ch1 + i, n - i);
+}
+
+inline const Kernels& NeonKernels() {
+  static const Kernels k = {"neon", U8ToFloatNeon, S16ToFloatNeon,
+                            S24ToFloatNeon, S32ToFloatNeon, F32ToFloatScalar,
+                            StereoNeon};
+  return k;
+}
+
+#endif  // PCM_CONVERT_NEON
+
+// All kernel sets usable on this CPU, best first (the scalar set is always last).
+inline int AvailableKernels(const Kernels** out) {
+  int n = 0;
+#ifdef PCM_CONVERT_X86
+  if (CpuHasAvx2()) out[n++] = &Avx2Kernels();
+  if (CpuHasSse41()) out[n++] = &Sse41Kernels();
+#endif
+#ifdef PCM_CONVERT_NEON
+  out[n++] = &NeonKernels();
+#endif
+  out[n++] = &ScalarKernels();
+  return n;
+}
+
+// The kernel set selected for this CPU (detected once, thread-safe).
+inline const Kernels& Active() {
+  static const Kernels* best = [] {
+    const Kernels* all[4];
+    AvailableKernels(all);
+    return all[0];
+  }();
+  return *best;
+}
+
+inline void U8ToFloat(const void* in, float* out, size_t n) { Active().u8(in, out, n); }
+inline void S16ToFloat(const void* in, float* out, size_t n) { Active().s16(in, out, n); }
+inline void S24ToFloat(const void* in, float* out, size_t n) { Active().s24(in, out, n); }
+inline void S32ToFloat(const void* in, float* out, size_t n) { Active().s32(in, out, n); }
+inline void F32ToFloat(const void* in, float* out, size_t n) { Active().f32(in, out, n); }
+
+// Converts n samples of `bits` bits (format_tag 1 = integer PCM, 3 = IEEE float).
+// Returns false for unsupported combinations.
+inline bool ToFloat(int format_tag, int bits, const void* in, float* out, size_t n) {
+  const Kernels& k = Active();
+  if (format_tag == 3 && bits == 32) k.f32(in, out, n);
+  else if (bits == 8) k.u8(in, out, n);
+  else if (bits == 16) k.s16(in, out, n);
+  else if (bits == 24) k.s24(in, out, n);
+  else if (bits == 32) k.s32(in, out, n);
+  else return false;
+  return true;
+}
+
+// Splits n interleaved frames of `channels` channels into out[0..channels).
+inline void Deinterleave(const float* in, int channels, float* const* out,
+                         size_t n) {
+  if (channels == 1) {
+    memcpy(out[0], in, n * sizeof(float));
+  } else if (channels == 2) {
+    Active().stereo(in, out[0], out[1], n);
+  } else {
+    for (int c = 0; c < channels; ++c) {
+      float* dst = out[c];
+      for (size_t i = 0; i < n; ++i) dst[i] = in[i * channels + c];
+    }
+  }
+}
+
+}  // namespace pcm
+
+#endif  // FRONTEND_PCM_CONVERT_H_
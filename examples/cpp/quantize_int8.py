@@ -0,0 +1,24 @@
+# Builds silero_vad_int8.onnx (VAD_PRECISION_INT8) by dynamic int8 quantization.
+#
+# Weights of the Conv and LSTM ops are stored as int8, and activations are quantized on the
+# fly. IO stays float32, so the C++ side is unchanged. The 16 kHz op15 export is the source
+# because its graph has no 8 kHz branch.
+#
+# Usage: pip install onnxruntime onnx && python quantize_int8.py [src.onnx] [dst.onnx]
+import os
+import sys
+
+from onnxruntime.quantization import QuantType, quant_pre_process, quantize_dynamic
+
+if __name__ == '__main__':
+    src = sys.argv[1] if len(sys.argv) > 1 else '../../src/silero_vad/data/silero_vad_16k_op15.onnx'
+    dst = sys.argv[2] if len(sys.argv) > 2 else '../../src/silero_vad/data/silero_vad_int8.onnx'
+
+    prepared = dst + '.prep.onnx'
+    quant_pre_process(src, prepared, skip_symbolic_shape=True)
+    quantize_dynamic(prepared, dst,
+                     op_types_to_quantize=['Conv', 'LSTM', 'MatMul'],
+                     weight_type=QuantType.QInt8,
+                     per_channel=True)
+    os.remove(prepared)
+    print(f'Wrote {dst}')
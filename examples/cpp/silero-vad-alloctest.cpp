@@ -0,0 +1,170 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Steady-state allocation check for VadIterator.
+//
+// Replaces the global operator new with a counting one, then for every input path:
+//   process      : process() over the whole recording
+//   feed         : feed() in 100 ms chunks (not window-aligned)
+//   feed_odd     : feed() in 7-sample chunks
+//   feed_from    : feed_from() converting 16-bit PCM in place, 1000-sample chunks
+//   feed_window  : feed_window() with [context | window] views
+//   resample_48k : feed() of 48 kHz audio with set_input_sample_rate(48000)
+// it runs the recording once to warm up (buffers, segment list), reset()s, runs it again
+// and counts the heap allocations of the second pass.
+//
+// Allocations inside ONNX Runtime's Session::Run are not VadIterator's to remove. They are
+// measured separately (session_run: the same number of windows through a bare VadOrtIo on
+// the same model) and allowed, plus one window's worth for rounding. Any other allocation
+// is a failure: the program prints the counts and exits with status 1.
+//
+// Usage: ./alloctest [--model silero_vad.onnx] [--seconds 30]
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-testaudio.h"
+
+// ----- Heap allocation counting -----
+// Kept out of line: once GCC inlines them into the callers it pairs malloc/free with
+// new/delete and warns (-Wmismatched-new-delete).
+static std::atomic<long long> g_allocations{ 0 };
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ALLOCTEST_NOINLINE __attribute__((noinline))
+#else
+#define ALLOCTEST_NOINLINE
+#endif
+ALLOCTEST_NOINLINE void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+ALLOCTEST_NOINLINE void* operator new[](size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+ALLOCTEST_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+ALLOCTEST_NOINLINE void operator delete[](void* p) noexcept { ::operator delete(p); }
+ALLOCTEST_NOINLINE void operator delete(void* p, size_t) noexcept { ::operator delete(p); }
+ALLOCTEST_NOINLINE void operator delete[](void* p, size_t) noexcept { ::operator delete(p); }
+
+namespace {
+
+// Runs `pass` twice on a fresh iterator state and returns the allocations of the second run.
+long long steady_allocations(VadIterator& vad, const std::function<void()>& pass) {
+    vad.reset();
+    pass();
+    vad.reset();
+    long long before = g_allocations.load();
+    pass();
+    return g_allocations.load() - before;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = "../../src/silero_vad/data/silero_vad.onnx";
+    double seconds = 30.0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--model") model_arg = argv[i + 1];
+        else if (key == "--seconds") seconds = std::atof(argv[i + 1]);
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+    const int sample_rate = 16000;
+    std::vector<float> audio = make_test_audio(sample_rate, seconds, 11);
+    std::vector<float> audio_48k = make_test_audio(48000, seconds, 11);
+    std::vector<int16_t> pcm(audio.size());
+    for (size_t i = 0; i < audio.size(); i++)
+        pcm[i] = static_cast<int16_t>(std::max(-1.0f, std::min(1.0f, audio[i])) * 32767.0f);
+
+    VadIterator vad(VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end())));
+    const size_t window = static_cast<size_t>(vad.window_samples());
+    const size_t context = static_cast<size_t>(vad.effective_window_samples()) - window;
+    const size_t windows = audio.size() / window;
+
+    // What Session::Run itself allocates for `windows` windows, after a warm-up.
+    long long run_allocs;
+    {
+        std::shared_ptr<VadModel> model = VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end()));
+        VadOrtIo io(*model, sample_rate, static_cast<int>(window));
+        for (int pass = 0; pass < 2; pass++) {
+            long long before = g_allocations.load();
+            for (size_t w = 0; w < windows; w++) {
+                std::copy(audio.begin() + w * window, audio.begin() + (w + 1) * window, io.input() + context);
+                io.run(*model);
+                io.advance();
+            }
+            run_allocs = g_allocations.load() - before;
+        }
+    }
+    const long long allowed = run_allocs + (run_allocs + windows - 1) / windows;
+
+    struct Case {
+        const char* name;
+        std::function<void()> pass;
+    };
+    std::vector<Case> cases;
+    cases.push_back({ "process", [&]() {
+        vad.process(audio.data(), audio.size());
+    } });
+    cases.push_back({ "feed", [&]() {
+        for (size_t pos = 0; pos < audio.size(); pos += 1600)
+            vad.feed(audio.data() + pos, std::min<size_t>(1600, audio.size() - pos));
+        vad.flush();
+    } });
+    cases.push_back({ "feed_odd", [&]() {
+        for (size_t pos = 0; pos < audio.size(); pos += 7)
+            vad.feed(audio.data() + pos, std::min<size_t>(7, audio.size() - pos));
+        vad.flush();
+    } });
+    cases.push_back({ "feed_from", [&]() {
+        for (size_t pos = 0; pos < pcm.size(); pos += 1000) {
+            const int16_t* src = pcm.data() + pos;
+            vad.feed_from([src](float* dst, size_t offset, size_t count) {
+                for (size_t i = 0; i < count; i++)
+                    dst[i] = src[offset + i] / 32768.0f;
+            }, std::min<size_t>(1000, pcm.size() - pos));
+        }
+        vad.flush();
+    } });
+    cases.push_back({ "feed_window", [&]() {
+        for (size_t pos = context; pos + window <= audio.size(); pos += window)
+            vad.feed_window(audio.data() + pos - context);
+        vad.flush();
+    } });
+    cases.push_back({ "resample_48k", [&]() {
+        for (size_t pos = 0; pos < audio_48k.size(); pos += 4800)
+            vad.feed(audio_48k.data() + pos, std::min<size_t>(4800, audio_48k.size() - pos));
+        vad.flush();
+    } });
+
+    // set_input_sample_rate() allocates the resampler by design; do it before counting.
+    int failures = 0;
+    printf("{\n  \"windows_per_pass\": %zu,\n  \"session_run\": %lld,\n  \"allocations\": {\n", windows, run_allocs);
+    for (size_t c = 0; c < cases.size(); c++) {
+        if (std::string(cases[c].name) == "resample_48k")
+            vad.set_input_sample_rate(48000);
+        long long allocs = steady_allocations(vad, cases[c].pass);
+        failures += allocs > allowed;
+        printf("    \"%s\": %lld%s\n", cases[c].name, allocs, c + 1 < cases.size() ? "," : "");
+    }
+    printf("  },\n  \"result\": \"%s\"\n}\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
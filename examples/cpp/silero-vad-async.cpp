@@ -0,0 +1,195 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Asynchronous submission (AsyncVad): many streams with windows in flight on a fixed pool.
+//
+// One client thread submits the windows of --streams streams interleaved, as they would
+// arrive from live calls, without waiting for any result; the workers batch them. It then
+// collects the futures. When built as C++20, the same audio runs again with one coroutine
+// per stream that co_awaits each window. For each mode it reports:
+//   windows_per_sec  : throughput from the first submit to the last completion
+//   peak_in_flight   : most windows submitted but not completed at one time
+//   threads          : worker threads + the client thread
+//   max_prob_diff    : largest difference to VadIterator on the same audio (first --verify
+//                      streams); windows arriving out of order would show up here
+//   segments_match   : verified streams whose segments equal VadIterator's
+// Output is JSON.
+//
+// Usage: ./async [--model silero_vad.onnx] [--streams 1000] [--seconds 10] [--workers 0]
+//                [--verify 8]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "silero-vad-async.h"
+#include "silero-vad-testaudio.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct RunResult {
+    size_t windows = 0;
+    double seconds = 0.0;
+    size_t peak_in_flight = 0;
+    double max_prob_diff = 0.0;
+    size_t segments_match = 0;
+};
+
+// Probabilities and segments of the verified streams, run one at a time through VadIterator.
+struct Reference {
+    std::vector<std::vector<float>> probs;
+    std::vector<std::vector<timestamp_t>> segments;
+};
+
+void check(const std::vector<AsyncVad::Stream*>& streams,
+    const std::vector<std::vector<float>>& probs, const Reference& ref, RunResult& r) {
+    for (size_t s = 0; s < ref.probs.size(); s++) {
+        for (size_t i = 0; i < ref.probs[s].size(); i++)
+            r.max_prob_diff = std::max(r.max_prob_diff, static_cast<double>(std::fabs(probs[s][i] - ref.probs[s][i])));
+    }
+    for (size_t s = 0; s < streams.size(); s++)
+        streams[s]->stream().flush();
+    for (size_t s = 0; s < ref.segments.size(); s++)
+        r.segments_match += streams[s]->stream().get_speech_timestamps() == ref.segments[s];
+}
+
+RunResult run_futures(std::shared_ptr<VadModel> model, size_t workers, const std::vector<float>& audio,
+    size_t num_streams, size_t windows, const Reference& ref) {
+    RunResult r;
+    AsyncVad vad(model, workers);
+    const size_t window = vad.window_samples();
+    std::vector<AsyncVad::Stream*> streams;
+    for (size_t s = 0; s < num_streams; s++)
+        streams.push_back(vad.open_stream());
+    std::vector<std::vector<std::future<float>>> futures(num_streams);
+    for (std::vector<std::future<float>>& f : futures)
+        f.reserve(windows);
+
+    Clock::time_point t = Clock::now();
+    for (size_t i = 0; i < windows; i++) {
+        for (size_t s = 0; s < num_streams; s++)
+            futures[s].push_back(vad.submit(streams[s], audio.data() + (s * 97) % 16000 + i * window));
+        r.peak_in_flight = std::max(r.peak_in_flight, vad.in_flight());
+    }
+    std::vector<std::vector<float>> probs(num_streams, std::vector<float>(windows));
+    for (size_t s = 0; s < num_streams; s++) {
+        for (size_t i = 0; i < windows; i++)
+            probs[s][i] = futures[s][i].get();
+    }
+    r.seconds = std::chrono::duration<double>(Clock::now() - t).count();
+    vad.drain();
+    r.windows = vad.windows_processed();
+    check(streams, probs, ref, r);
+    return r;
+}
+
+#ifdef SILERO_VAD_COROUTINES
+// Fire-and-forget coroutine: starts at once, frees its frame when it returns.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return Detached(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// One stream's client: each co_await suspends until its window ran, then submits the next.
+Detached stream_client(AsyncVad& vad, AsyncVad::Stream* s, const float* audio, size_t windows,
+    std::vector<float>& probs) {
+    for (size_t i = 0; i < windows; i++)
+        probs[i] = co_await vad.co_submit(s, audio + i * vad.window_samples());
+}
+
+RunResult run_coroutines(std::shared_ptr<VadModel> model, size_t workers, const std::vector<float>& audio,
+    size_t num_streams, size_t windows, const Reference& ref) {
+    RunResult r;
+    AsyncVad vad(model, workers);
+    std::vector<AsyncVad::Stream*> streams;
+    for (size_t s = 0; s < num_streams; s++)
+        streams.push_back(vad.open_stream());
+    std::vector<std::vector<float>> probs(num_streams, std::vector<float>(windows));
+
+    Clock::time_point t = Clock::now();
+    for (size_t s = 0; s < num_streams; s++)
+        stream_client(vad, streams[s], audio.data() + (s * 97) % 16000, windows, probs[s]);
+    r.peak_in_flight = vad.in_flight();
+    vad.drain();
+    r.seconds = std::chrono::duration<double>(Clock::now() - t).count();
+    r.windows = vad.windows_processed();
+    check(streams, probs, ref, r);
+    return r;
+}
+#endif
+
+void print_run(const char* name, const RunResult& r, size_t threads, size_t verified, bool last) {
+    printf("  \"%s\": {\"windows\": %zu, \"windows_per_sec\": %.1f, \"peak_in_flight\": %zu, \"threads\": %zu, "
+        "\"max_prob_diff\": %.3g, \"segments_match\": \"%zu/%zu\"}%s\n",
+        name, r.windows, r.windows / r.seconds, r.peak_in_flight, threads, r.max_prob_diff,
+        r.segments_match, verified, last ? "" : ",");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = "../../src/silero_vad/data/silero_vad.onnx";
+    size_t num_streams = 1000;
+    double seconds = 10.0;
+    size_t workers = 0;
+    size_t verify = 8;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--model") model_arg = argv[i + 1];
+        else if (key == "--streams") num_streams = std::stoul(argv[i + 1]);
+        else if (key == "--seconds") seconds = std::stod(argv[i + 1]);
+        else if (key == "--workers") workers = std::stoul(argv[i + 1]);
+        else if (key == "--verify") verify = std::stoul(argv[i + 1]);
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    const int sample_rate = 16000;
+    const size_t window = 512;
+    const size_t windows = static_cast<size_t>(seconds * sample_rate) / window;
+    verify = std::min(verify, num_streams);
+
+    // Streams read the same audio at different offsets (up to one second in).
+    std::vector<float> audio = make_test_audio(sample_rate, seconds + 1.0, 22);
+    std::shared_ptr<VadModel> model = VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end()));
+
+    Reference ref;
+    for (size_t s = 0; s < verify; s++) {
+        VadIterator it(model);
+        const float* p = audio.data() + (s * 97) % sample_rate;
+        ref.probs.emplace_back();
+        for (size_t i = 0; i < windows; i++) {
+            it.feed(p + i * window, window);
+            ref.probs.back().push_back(it.last_speech_prob());
+        }
+        it.flush();
+        ref.segments.push_back(it.get_speech_timestamps());
+    }
+
+    RunResult futures = run_futures(model, workers, audio, num_streams, windows, ref);
+    const size_t threads = (workers ? workers : std::max(1u, std::thread::hardware_concurrency())) + 1;
+    printf("{\n  \"streams\": %zu,\n  \"seconds_per_stream\": %.1f,\n", num_streams, seconds);
+#ifdef SILERO_VAD_COROUTINES
+    RunResult coroutines = run_coroutines(model, workers, audio, num_streams, windows, ref);
+    print_run("futures", futures, threads, verify, false);
+    print_run("coroutines", coroutines, threads, verify, true);
+#else
+    print_run("futures", futures, threads, verify, true);
+#endif
+    printf("}\n");
+    return 0;
+}
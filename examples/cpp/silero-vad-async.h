@@ -0,0 +1,158 @@
+#ifndef SILERO_VAD_ASYNC_H_
+#define SILERO_VAD_ASYNC_H_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <functional>
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#define SILERO_VAD_COROUTINES 1
+#endif
+
+#include "silero-vad-scheduler.h"
+
+// AsyncVad class: submit-and-continue inference for many streams.
+//
+// Each submit() queues one window of a stream and returns at once; the probability is
+// delivered later through a std::future, a callback, or (C++20) co_await. The windows run
+// on the internal VadScheduler: a fixed worker pool sharing one model, batching windows of
+// different streams into one Session::Run. Any number of windows of any number of streams
+// can be in flight without a thread per stream.
+//
+// Windows of one stream complete in submission order, each with the LSTM state left by the
+// previous one. Concurrent submit() calls on the same stream are serialized; the order in
+// which they take the stream is the order they are processed in.
+//
+// Completions run on worker threads. Callbacks and resumed coroutines should hand off any
+// long work, as the worker's other streams wait for them.
+class AsyncVad {
+public:
+    typedef std::function<void(float)> Completion;
+
+    // A stream opened with open_stream(). Its VadStream holds the segments; read it after
+    // drain(), after its last window completed, or from its own speech callbacks.
+    class Stream {
+    private:
+        friend class AsyncVad;
+
+        VadScheduler::Stream* handle = nullptr;
+        std::mutex mutex;                    // Guards pending; held while a window is queued
+        std::deque<Completion> pending;      // One per window in flight, in submission order
+
+    public:
+        VadStream& stream() { return handle->stream(); }
+        const VadStream& stream() const { return handle->stream(); }
+    };
+
+private:
+    std::deque<std::unique_ptr<Stream>> streams;   // Outlives the scheduler's workers
+    std::mutex streams_mutex;                      // Guards streams
+    std::atomic<size_t> in_flight_windows{ 0 };
+    int window_size_samples;
+    VadScheduler scheduler;
+
+    void complete(Stream* s, float prob) {
+        Completion done;
+        {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            done = std::move(s->pending.front());
+            s->pending.pop_front();
+        }
+        in_flight_windows--;
+        done(prob);
+    }
+
+public:
+    // num_workers == 0 uses one worker per hardware thread.
+    AsyncVad(std::shared_ptr<VadModel> Model, size_t num_workers = 0, size_t Max_batch = 64,
+        int Sample_rate = 16000, int Windows_frame_size = 32)
+        : window_size_samples(Windows_frame_size * (Sample_rate / 1000)),
+          scheduler(std::move(Model), num_workers, Max_batch, Sample_rate, Windows_frame_size)
+    {
+    }
+
+    // Waits for every submitted window, so no completion is lost.
+    ~AsyncVad() {
+        scheduler.drain();
+    }
+
+    AsyncVad(const AsyncVad&) = delete;
+    AsyncVad& operator=(const AsyncVad&) = delete;
+
+    // Opens a stream; the returned pointer stays valid for the AsyncVad's lifetime.
+    // The parameters match VadIterator's segmentation parameters.
+    Stream* open_stream(float Threshold = 0.5, int min_silence_duration_ms = 100,
+        int speech_pad_ms = 30, int min_speech_duration_ms = 250,
+        float max_speech_duration_s = std::numeric_limits<float>::infinity()) {
+        std::unique_ptr<Stream> s(new Stream());
+        s->handle = scheduler.add_stream(Threshold, min_silence_duration_ms, speech_pad_ms,
+            min_speech_duration_ms, max_speech_duration_s);
+        Stream* raw = s.get();
+        s->stream().set_window_callback([this, raw](float prob) { complete(raw, prob); });
+        std::lock_guard<std::mutex> lock(streams_mutex);
+        streams.push_back(std::move(s));
+        return raw;
+    }
+
+    // Queues one window (window_samples() samples, copied) and calls done with its speech
+    // probability once it ran. Never blocks on inference.
+    void submit(Stream* s, const float* window, Completion done) {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        s->pending.push_back(std::move(done));
+        in_flight_windows++;
+        scheduler.feed(s->handle, window, window_size_samples);
+    }
+
+    // Queues one window and returns a future for its speech probability.
+    std::future<float> submit(Stream* s, const float* window) {
+        std::shared_ptr<std::promise<float>> promise = std::make_shared<std::promise<float>>();
+        std::future<float> result = promise->get_future();
+        submit(s, window, [promise](float prob) { promise->set_value(prob); });
+        return result;
+    }
+
+#ifdef SILERO_VAD_COROUTINES
+    // Awaitable returned by co_submit(). The coroutine resumes on the worker that ran the window.
+    class SubmitAwaiter {
+    private:
+        AsyncVad* vad;
+        Stream* stream;
+        const float* window;
+        float prob = 0.0f;
+
+    public:
+        SubmitAwaiter(AsyncVad* Vad, Stream* S, const float* Window) : vad(Vad), stream(S), window(Window) {}
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            // The completion may resume the coroutine before submit() returns; nothing
+            // touches the awaiter after it.
+            vad->submit(stream, window, [this, h](float p) { prob = p; h.resume(); });
+        }
+        float await_resume() const noexcept { return prob; }
+    };
+
+    // float prob = co_await vad.co_submit(stream, window);
+    SubmitAwaiter co_submit(Stream* s, const float* window) {
+        return SubmitAwaiter(this, s, window);
+    }
+#endif
+
+    // Blocks until every window submitted so far has completed.
+    void drain() {
+        scheduler.drain();
+    }
+
+    // Windows submitted whose completion has not run yet.
+    size_t in_flight() const { return in_flight_windows; }
+
+    int window_samples() const { return window_size_samples; }
+    size_t num_workers() const { return scheduler.num_workers(); }
+    size_t windows_processed() const { return scheduler.windows_processed(); }
+};
+
+#endif  // SILERO_VAD_ASYNC_H_
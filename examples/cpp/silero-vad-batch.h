@@ -0,0 +1,209 @@
+#ifndef SILERO_VAD_BATCH_H_
+#define SILERO_VAD_BATCH_H_
+
+#include <vector>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <functional>
+
+#include "onnxruntime_cxx_api.h"
+#include "silero-vad-onnx.h"
+
+class BatchedVadEngine;
+
+// VadStream class: one independent audio stream driven by a BatchedVadEngine.
+// It only holds per-stream state (context, LSTM state, queued samples and the segment
+// state machine); the model lives in the engine and is shared by all streams.
+class VadStream {
+private:
+    friend class BatchedVadEngine;
+
+    int context_samples;  // 64 samples at 16 kHz, 32 at 8 kHz
+    int sample_rate;
+    int window_size_samples;
+
+    std::vector<float> _context;     // Last context_samples of the previous window
+    std::vector<float> _state;       // LSTM state of this stream, layout {2, VadOrtIo::kStateSize}
+    std::vector<float> queue;        // Samples fed but not yet run through the model
+    size_t read_pos = 0;             // Start of the next window in `queue`
+    int64_t audio_length_samples = 0;
+
+    VadSegmenter segmenter;
+    std::function<void(float)> on_window;
+
+    const float* next_window() const {
+        return queue.data() + read_pos;
+    }
+
+public:
+    // The parameters match VadIterator (minus the model, which belongs to the engine).
+    VadStream(int Sample_rate = 16000, int windows_frame_size = 32,
+        float Threshold = 0.5, int min_silence_duration_ms = 100,
+        int speech_pad_ms = 30, int min_speech_duration_ms = 250,
+        float max_speech_duration_s = std::numeric_limits<float>::infinity())
+        : sample_rate(Sample_rate)
+    {
+        context_samples = vad_context_samples(sample_rate);
+        window_size_samples = windows_frame_size * (sample_rate / 1000);
+        _context.assign(context_samples, 0.0f);
+        _state.assign(2 * VadOrtIo::kStateSize, 0.0f);
+        segmenter = VadSegmenter(sample_rate, window_size_samples, Threshold, min_silence_duration_ms,
+            speech_pad_ms, min_speech_duration_ms, max_speech_duration_s);
+    }
+
+    // Queues samples for the engine. Any amount is accepted; windows are taken in order.
+    void feed(const float* samples, size_t num_samples) {
+        if (read_pos > 0) {
+            queue.erase(queue.begin(), queue.begin() + read_pos);
+            read_pos = 0;
+        }
+        queue.insert(queue.end(), samples, samples + num_samples);
+        audio_length_samples += static_cast<int64_t>(num_samples);
+    }
+
+    // True if at least one whole window is queued.
+    bool has_window() const {
+        return queue.size() - read_pos >= static_cast<size_t>(window_size_samples);
+    }
+
+    // Ends the stream once the engine has drained it: closes an open speech segment.
+    // A trailing partial window is dropped, as in VadIterator::process().
+    void flush() {
+        segmenter.flush(audio_length_samples);
+    }
+
+    // Clears all state so the stream can be reused.
+    void reset() {
+        std::fill(_context.begin(), _context.end(), 0.0f);
+        std::fill(_state.begin(), _state.end(), 0.0f);
+        queue.clear();
+        read_pos = 0;
+        audio_length_samples = 0;
+        segmenter.reset();
+    }
+
+    // Registers listeners for live segment events (either may be empty).
+    void set_speech_callbacks(std::function<void(int64_t)> on_start,
+        std::function<void(const timestamp_t&)> on_end) {
+        segmenter.set_speech_callbacks(std::move(on_start), std::move(on_end));
+    }
+
+    // Registers a listener that receives the speech probability of every window, in order,
+    // right after it ran. It is called on the thread that runs the engine.
+    void set_window_callback(std::function<void(float)> on_prob) {
+        on_window = std::move(on_prob);
+    }
+
+    // Returns the detected speech timestamps (in samples).
+    const std::vector<timestamp_t>& get_speech_timestamps() const {
+        return segmenter.get_speech_timestamps();
+    }
+};
+
+// BatchedVadEngine class: runs the next window of many independent streams in a single
+// Session::Run. The windows are gathered into one {N, 576} input and the per-stream LSTM
+// states into one {2, N, 128} state tensor; probabilities and new states are scattered
+// back afterwards. N may differ on every step (up to max_batch per Run).
+class BatchedVadEngine {
+private:
+    // ONNX Runtime resources (the model may be shared with other engines)
+    std::shared_ptr<VadModel> model;
+
+    int context_samples;
+    int sample_rate;
+    int window_size_samples;
+    size_t max_batch;
+
+    // Batch buffers sized for max_batch; a Run with N streams uses the first N rows.
+    VadOrtIo io;
+    std::vector<VadStream*> ready;
+
+    // Runs one window of each of the n streams in a single inference call.
+    void run_batch(VadStream* const* streams, size_t n) {
+        const size_t state_size = VadOrtIo::kStateSize;
+        for (size_t b = 0; b < n; b++) {
+            const VadStream& s = *streams[b];
+            float* row = io.input(b);
+            std::memcpy(row, s._context.data(), context_samples * sizeof(float));
+            std::memcpy(row + context_samples, s.next_window(), window_size_samples * sizeof(float));
+            for (size_t k = 0; k < 2; k++)
+                std::memcpy(io.state(k, b, n), s._state.data() + k * state_size, state_size * sizeof(float));
+        }
+
+        io.run(*model, n);
+
+        for (size_t b = 0; b < n; b++) {
+            VadStream& s = *streams[b];
+            const float* row = io.input(b);
+            std::memcpy(s._context.data(), row + window_size_samples, context_samples * sizeof(float));
+            for (size_t k = 0; k < 2; k++)
+                std::memcpy(s._state.data() + k * state_size, io.next_state(k, b, n), state_size * sizeof(float));
+            s.read_pos += window_size_samples;
+            s.segmenter.push(io.output(b));
+            if (s.on_window)
+                s.on_window(io.output(b));
+        }
+    }
+
+public:
+    BatchedVadEngine(const std::basic_string<ORTCHAR_T>& ModelPath, size_t Max_batch = 64,
+        int Sample_rate = 16000, int windows_frame_size = 32, int intra_threads = 1)
+        : BatchedVadEngine(VadModel::get(ModelPath, VadModelOptions(intra_threads, 1)),
+            Max_batch, Sample_rate, windows_frame_size)
+    {
+    }
+
+    // Shares an already loaded model, e.g. one VadModel for every worker thread.
+    BatchedVadEngine(std::shared_ptr<VadModel> Model, size_t Max_batch = 64,
+        int Sample_rate = 16000, int windows_frame_size = 32)
+        : model(std::move(Model)), sample_rate(Sample_rate), max_batch(Max_batch),
+          io(*model, Sample_rate, windows_frame_size * (Sample_rate / 1000), Max_batch)
+    {
+        if (max_batch == 0)
+            throw std::invalid_argument("BatchedVadEngine: max_batch must be positive");
+        context_samples = io.context_samples();
+        window_size_samples = io.window_samples();
+        ready.reserve(max_batch);
+    }
+
+    // Runs the next window of every stream that has one queued, max_batch streams per
+    // inference call. Returns the number of windows processed (0 when all are drained).
+    size_t step(VadStream* const* streams, size_t count) {
+        size_t done = 0;
+        ready.clear();
+        for (size_t i = 0; i < count; i++) {
+            VadStream* s = streams[i];
+            if (s->sample_rate != sample_rate || s->window_size_samples != window_size_samples)
+                throw std::invalid_argument("BatchedVadEngine: stream sample rate/window size mismatch");
+            if (!s->has_window())
+                continue;
+            ready.push_back(s);
+            if (ready.size() == max_batch) {
+                run_batch(ready.data(), ready.size());
+                done += ready.size();
+                ready.clear();
+            }
+        }
+        if (!ready.empty()) {
+            run_batch(ready.data(), ready.size());
+            done += ready.size();
+            ready.clear();
+        }
+        return done;
+    }
+
+    // Steps until no stream has a whole window queued. Returns the number of windows processed.
+    size_t run(VadStream* const* streams, size_t count) {
+        size_t total = 0;
+        for (size_t n; (n = step(streams, count)) > 0; )
+            total += n;
+        return total;
+    }
+
+    size_t get_max_batch() const { return max_batch; }
+};
+
+#endif  // SILERO_VAD_BATCH_H_
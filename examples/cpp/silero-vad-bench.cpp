@@ -0,0 +1,521 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Self-contained benchmark for the C++ VAD backends. It generates its own audio
+// (speech-like voiced bursts, noise and silence), so no assets are needed, and
+// prints one JSON object so results can be tracked across versions.
+//
+// Measured:
+//   onnx      : per-window latency p50/p99/max, real-time factor, windows/sec on one
+//               core and per core with the multi-core scheduler, heap allocations
+//               per window in steady state
+//   wav       : WavReader::Open / MmapWavReader / WavStreamReader decode throughput,
+//               WAV-open-to-first-probability time
+//   libtorch  : the same latency/RTF numbers for silero::VadIterator when built
+//               with -DSILERO_BENCH_LIBTORCH, plus libtorch_file: one SpeechProbs()
+//               call over the whole recording, as the cpp_libtorch example runs a file,
+//               and libtorch_batched: silero::BatchedVad over 16 streams against the
+//               same streams run one by one (max probability difference) and against
+//               USE_BATCH-style batches of consecutive windows
+//   streams   : cost of creating 1000 iterators on one shared model (time, RSS growth)
+//   input_rates: per input sample rate, resampler throughput and the end-to-end real-time
+//               factor of VadIterator with set_input_sample_rate() (8 kHz runs natively)
+//   peak RSS  : of the whole run (Linux/macOS)
+//   stages    : per-stage ONNX latency when built with -DSILERO_VAD_STATS
+//
+// Usage: ./bench [--model silero_vad.onnx] [--jit silero_vad.jit] [--seconds 60]
+//                [--threads N] [--json out.json]
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-scheduler.h"
+#include "wav.h"
+#include "silero-vad-testaudio.h"
+#ifdef SILERO_BENCH_LIBTORCH
+#include "../cpp_libtorch/silero_torch.h"
+#include "../cpp_libtorch/silero_torch_batch.h"
+#endif
+
+// ----- Heap allocation counting -----
+// Every operator new in the process is counted; the benchmark reads the counter
+// around the steady-state loop. The replacements stay out of line: once GCC inlines them into
+// the callers it pairs malloc/free with new/delete and warns (-Wmismatched-new-delete).
+static std::atomic<long long> g_allocations{ 0 };
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+BENCH_NOINLINE void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+BENCH_NOINLINE void* operator new[](size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+BENCH_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void* p) noexcept { ::operator delete(p); }
+BENCH_NOINLINE void operator delete(void* p, size_t) noexcept { ::operator delete(p); }
+BENCH_NOINLINE void operator delete[](void* p, size_t) noexcept { ::operator delete(p); }
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double seconds_since(Clock::time_point begin) {
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty())
+        return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t idx = static_cast<size_t>(p * (v.size() - 1) + 0.5);
+    return v[idx];
+}
+
+double peak_rss_mb() {
+#ifndef _WIN32
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return ru.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return ru.ru_maxrss / 1024.0;
+#endif
+#else
+    return 0.0;
+#endif
+}
+
+// Current resident set size; Linux only (0 elsewhere).
+double current_rss_mb() {
+    double mb = 0.0;
+#ifdef __linux__
+    if (FILE* f = fopen("/proc/self/statm", "r")) {
+        long pages = 0, resident = 0;
+        if (fscanf(f, "%ld %ld", &pages, &resident) == 2)
+            mb = resident * (sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0));
+        fclose(f);
+    }
+#endif
+    return mb;
+}
+
+// Throughput at one input sample rate.
+struct RateResult {
+    int input_rate;
+    int model_rate;
+    double resample_x_realtime;  // resampler alone (0 when no resampling is needed)
+    double rtf;                  // resampling + VAD, processing time / audio duration
+};
+
+// Feeds `seconds` of audio at input_rate in 10 ms chunks, as from a live source.
+RateResult bench_input_rate(std::shared_ptr<VadModel> model, int input_rate, double seconds) {
+    RateResult r;
+    r.input_rate = input_rate;
+    r.model_rate = input_rate == 8000 ? 8000 : 16000;
+    r.resample_x_realtime = 0.0;
+    std::vector<float> audio = make_test_audio(input_rate, seconds, 3);
+    const size_t chunk = input_rate / 100;
+    const double audio_seconds = static_cast<double>(audio.size()) / input_rate;
+
+    if (input_rate != r.model_rate) {
+        StreamingResampler resampler(input_rate, r.model_rate);
+        std::vector<float> out;
+        out.reserve(resampler.max_output(chunk));
+        Clock::time_point t = Clock::now();
+        for (size_t pos = 0; pos + chunk <= audio.size(); pos += chunk) {
+            out.clear();
+            resampler.process(audio.data() + pos, chunk, out);
+        }
+        r.resample_x_realtime = audio_seconds / seconds_since(t);
+    }
+
+    VadIterator vad(model, r.model_rate);
+    vad.set_input_sample_rate(input_rate);
+    Clock::time_point t = Clock::now();
+    for (size_t pos = 0; pos + chunk <= audio.size(); pos += chunk)
+        vad.feed(audio.data() + pos, chunk);
+    vad.flush();
+    r.rtf = seconds_since(t) / audio_seconds;
+    return r;
+}
+
+struct LatencyResult {
+    size_t windows = 0;
+    double p50_us = 0, p99_us = 0, max_us = 0, mean_us = 0;
+    double rtf = 0;              // processing time / audio duration
+    double windows_per_sec = 0;  // single core
+    double allocs_per_window = 0;
+};
+
+void print_latency(FILE* out, const char* name, const LatencyResult& r, bool last) {
+    fprintf(out,
+        "  \"%s\": {\"windows\": %zu, \"latency_us\": {\"p50\": %.2f, \"p99\": %.2f, \"max\": %.2f, \"mean\": %.2f}, "
+        "\"rtf\": %.6f, \"windows_per_sec\": %.1f, \"allocs_per_window\": %.3f}%s\n",
+        name, r.windows, r.p50_us, r.p99_us, r.max_us, r.mean_us, r.rtf, r.windows_per_sec,
+        r.allocs_per_window, last ? "" : ",");
+}
+
+// Feeds the audio one window at a time and times every window.
+LatencyResult bench_onnx(VadIterator& vad, const std::vector<float>& audio, int sample_rate, int window) {
+    LatencyResult r;
+    std::vector<double> lat;
+    lat.reserve(audio.size() / window + 1);
+
+    // Warm-up (ORT arena, first-run graph setup).
+    vad.reset();
+    for (size_t i = 0; i + window <= audio.size() && i < static_cast<size_t>(window) * 100; i += window)
+        vad.feed(audio.data() + i, window);
+    vad.reset();
+    SILERO_VAD_STATS_DO(vad.reset_stats());
+
+    long long allocs_before = g_allocations.load();
+    Clock::time_point total = Clock::now();
+    for (size_t i = 0; i + window <= audio.size(); i += window) {
+        Clock::time_point t = Clock::now();
+        vad.feed(audio.data() + i, window);
+        lat.push_back(seconds_since(t) * 1e6);
+    }
+    double elapsed = seconds_since(total);
+    long long allocs = g_allocations.load() - allocs_before;
+    vad.flush();
+
+    r.windows = lat.size();
+    r.p50_us = percentile(lat, 0.50);
+    r.p99_us = percentile(lat, 0.99);
+    r.max_us = percentile(lat, 1.0);
+    r.mean_us = elapsed * 1e6 / r.windows;
+    r.rtf = elapsed / (static_cast<double>(audio.size()) / sample_rate);
+    r.windows_per_sec = r.windows / elapsed;
+    r.allocs_per_window = static_cast<double>(allocs) / r.windows;
+    return r;
+}
+
+#ifdef SILERO_BENCH_LIBTORCH
+LatencyResult bench_libtorch(const std::string& jit_path, const std::vector<float>& audio, int sample_rate) {
+    LatencyResult r;
+    silero::VadIterator vad(jit_path);
+    vad.sample_rate = sample_rate;
+    vad.SetVariables();
+    const int window = sample_rate / 1000 * vad.window_size_ms;
+    std::vector<float> chunk(window);
+    std::vector<double> lat;
+
+    long long allocs_before = g_allocations.load();
+    Clock::time_point total = Clock::now();
+    for (size_t i = 0; i + window <= audio.size(); i += window) {
+        std::copy(audio.begin() + i, audio.begin() + i + window, chunk.begin());
+        Clock::time_point t = Clock::now();
+        vad.SpeechProbs(chunk);
+        lat.push_back(seconds_since(t) * 1e6);
+    }
+    double elapsed = seconds_since(total);
+    long long allocs = g_allocations.load() - allocs_before;
+    vad.GetSpeechTimestamps();
+
+    r.windows = lat.size();
+    r.p50_us = percentile(lat, 0.50);
+    r.p99_us = percentile(lat, 0.99);
+    r.max_us = percentile(lat, 1.0);
+    r.mean_us = elapsed * 1e6 / r.windows;
+    r.rtf = elapsed / (static_cast<double>(audio.size()) / sample_rate);
+    r.windows_per_sec = r.windows / elapsed;
+    r.allocs_per_window = static_cast<double>(allocs) / r.windows;
+    return r;
+}
+
+struct FileResult {
+    size_t windows = 0;
+    double rtf = 0;
+    double windows_per_sec = 0;
+    double allocs_per_window = 0;
+};
+
+// The whole recording in one SpeechProbs() call (best of three).
+FileResult bench_libtorch_file(const std::string& jit_path, const std::vector<float>& audio, int sample_rate) {
+    FileResult r;
+    silero::VadIterator vad(jit_path);
+    vad.sample_rate = sample_rate;
+    vad.SetVariables();
+    std::vector<float> input(audio);
+    r.windows = audio.size() / (sample_rate / 1000 * vad.window_size_ms);
+    double best = 1e30;
+    long long best_allocs = 0;
+    for (int run = 0; run < 3; run++) {
+        long long allocs_before = g_allocations.load();
+        Clock::time_point t = Clock::now();
+        vad.SpeechProbs(input);
+        double elapsed = seconds_since(t);
+        long long allocs = g_allocations.load() - allocs_before;
+        vad.GetSpeechTimestamps();  // also resets the iterator
+        if (elapsed < best) {
+            best = elapsed;
+            best_allocs = allocs;
+        }
+    }
+    r.rtf = best / (static_cast<double>(audio.size()) / sample_rate);
+    r.windows_per_sec = r.windows / best;
+    r.allocs_per_window = static_cast<double>(best_allocs) / r.windows;
+    return r;
+}
+
+struct TorchBatchResult {
+    int streams = 0;
+    double windows_per_sec = 0;            // BatchedVad, all streams
+    double sequential_windows_per_sec = 0; // one window per forward, stream after stream
+    double use_batch_windows_per_sec = 0;  // batches of consecutive windows of one stream
+    double max_prob_diff = 0;              // BatchedVad vs sequential
+};
+
+TorchBatchResult bench_libtorch_batched(const std::string& jit_path, const std::vector<float>& audio,
+    int sample_rate, int streams) {
+    TorchBatchResult r;
+    r.streams = streams;
+    silero::BatchedVad batched(jit_path, streams, sample_rate);
+    const int window = batched.WindowSize();
+    const size_t steps = audio.size() / window;
+    // Every stream reads the audio from a different offset.
+    auto sample = [&](int s, size_t step, int k) {
+        return audio[((step + s * steps / streams) % steps) * window + k];
+    };
+
+    std::vector<float> seq(static_cast<size_t>(streams) * steps);
+    {
+        torch::jit::script::Module model = torch::jit::load(jit_path);
+        model.eval();
+        torch::NoGradGuard no_grad;
+        torch::Tensor chunk = torch::zeros({ 1, window }, torch::kFloat32);
+        std::vector<torch::jit::IValue> inputs = { chunk, sample_rate };
+        Clock::time_point t = Clock::now();
+        for (int s = 0; s < streams; s++) {
+            model.run_method("reset_states");
+            for (size_t step = 0; step < steps; step++) {
+                for (int k = 0; k < window; k++)
+                    chunk.data_ptr<float>()[k] = sample(s, step, k);
+                seq[s * steps + step] = model.forward(inputs).toTensor().data_ptr<float>()[0];
+            }
+        }
+        r.sequential_windows_per_sec = streams * steps / seconds_since(t);
+
+        // USE_BATCH: `streams` consecutive windows of one stream per forward call.
+        model.run_method("reset_states");
+        size_t done = 0;
+        t = Clock::now();
+        for (size_t step = 0; step + streams <= steps; step += streams) {
+            inputs[0] = torch::from_blob(const_cast<float*>(audio.data()) + step * window, { streams, window },
+                torch::kFloat32);
+            model.forward(inputs);
+            done += streams;
+        }
+        r.use_batch_windows_per_sec = done / seconds_since(t);
+    }
+
+    std::vector<float> windows(static_cast<size_t>(streams) * window), probs(streams);
+    Clock::time_point t = Clock::now();
+    for (size_t step = 0; step < steps; step++) {
+        for (int s = 0; s < streams; s++)
+            for (int k = 0; k < window; k++)
+                windows[s * window + k] = sample(s, step, k);
+        batched.Process(windows, probs);
+        for (int s = 0; s < streams; s++)
+            r.max_prob_diff = std::max(r.max_prob_diff, static_cast<double>(std::fabs(probs[s] - seq[s * steps + step])));
+    }
+    r.windows_per_sec = streams * steps / seconds_since(t);
+    return r;
+}
+#endif
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = "../../src/silero_vad/data/silero_vad.onnx";
+    std::string jit_path = "../../src/silero_vad/data/silero_vad.jit";
+    std::string json_path;
+    double seconds = 60.0;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--model") model_arg = argv[i + 1];
+        else if (key == "--jit") jit_path = argv[i + 1];
+        else if (key == "--seconds") seconds = std::stod(argv[i + 1]);
+        else if (key == "--threads") threads = std::stoi(argv[i + 1]);
+        else if (key == "--json") json_path = argv[i + 1];
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    const std::wstring model_path(model_arg.begin(), model_arg.end());
+    const int sample_rate = 16000;
+    const int window = 512;
+
+    std::vector<float> audio = make_test_audio(sample_rate, seconds, 1);
+
+    // ----- ONNX VadIterator, single stream -----
+    VadIterator vad(model_path, sample_rate);
+    LatencyResult onnx = bench_onnx(vad, audio, sample_rate, window);
+
+    // ----- Stream creation on the shared model -----
+    auto model = VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end()));
+    const int created_streams = 1000;
+    double create_us, rss_per_stream_kb;
+    {
+        std::vector<std::unique_ptr<VadIterator>> iterators;
+        iterators.reserve(created_streams);
+        double rss_before = current_rss_mb();
+        Clock::time_point t = Clock::now();
+        for (int i = 0; i < created_streams; i++)
+            iterators.emplace_back(new VadIterator(model, sample_rate));
+        create_us = seconds_since(t) * 1e6 / created_streams;
+        rss_per_stream_kb = (current_rss_mb() - rss_before) * 1024.0 / created_streams;
+    }
+
+    // ----- ONNX, all cores through the scheduler -----
+    const int num_streams = threads * 64;
+    double sched_wps = 0.0;
+    {
+        VadScheduler scheduler(model, threads);
+        std::vector<VadScheduler::Stream*> streams;
+        for (int s = 0; s < num_streams; s++)
+            streams.push_back(scheduler.add_stream());
+        const size_t per_stream = std::min<size_t>(audio.size(), static_cast<size_t>(sample_rate) * 10);
+        Clock::time_point t = Clock::now();
+        for (size_t pos = 0; pos + sample_rate / 10 <= per_stream; pos += sample_rate / 10)
+            for (int s = 0; s < num_streams; s++)
+                scheduler.feed(streams[s], audio.data() + pos, sample_rate / 10);
+        scheduler.drain();
+        sched_wps = scheduler.windows_processed() / seconds_since(t);
+    }
+
+    // ----- Input sample rates -----
+    std::vector<RateResult> rates;
+    const int input_rates[] = { 8000, 16000, 22050, 44100, 48000 };
+    for (int rate : input_rates)
+        rates.push_back(bench_input_rate(model, rate, std::min(seconds, 20.0)));
+
+    // ----- WAV decoding -----
+    const std::string wav_path = "silero_vad_bench.wav";
+    {
+        std::vector<float> pcm(audio.size());
+        for (size_t i = 0; i < audio.size(); i++)
+            pcm[i] = std::max(-1.0f, std::min(1.0f, audio[i])) * 32767.0f;
+        wav::WavWriter writer(pcm.data(), static_cast<int>(pcm.size()), 1, sample_rate, 16);
+        writer.Write(wav_path);
+    }
+    const double wav_mb = audio.size() * 2 / 1e6;
+    double open_mbps, mmap_mbps, stream_mbps, first_prob_ms;
+    {
+        // WavReader::Open logs the header to std::cout; keep stdout clean for the JSON.
+        std::cout.setstate(std::ios::failbit);
+        Clock::time_point t = Clock::now();
+        wav::WavReader reader(wav_path);
+        open_mbps = wav_mb / seconds_since(t);
+        std::cout.clear();
+    }
+    {
+        std::vector<float> out(audio.size());
+        Clock::time_point t = Clock::now();
+        wav::MmapWavReader reader(wav_path);
+        reader.ReadFloat(0, reader.num_samples(), out.data());
+        mmap_mbps = wav_mb / seconds_since(t);
+    }
+    {
+        std::vector<float> block(sample_rate);
+        Clock::time_point t = Clock::now();
+        wav::WavStreamReader reader(wav_path);
+        while (reader.Read(block.data(), block.size()) > 0) {}
+        stream_mbps = wav_mb / seconds_since(t);
+    }
+    {
+        // From opening the file to the first speech probability.
+        VadIterator first(model_path, sample_rate);
+        std::vector<float> block(window);
+        Clock::time_point t = Clock::now();
+        wav::WavStreamReader reader(wav_path);
+        size_t n = reader.Read(block.data(), block.size());
+        first.feed(block.data(), n);
+        first_prob_ms = seconds_since(t) * 1e3;
+    }
+    std::remove(wav_path.c_str());
+
+#ifdef SILERO_BENCH_LIBTORCH
+    LatencyResult torch = bench_libtorch(jit_path, audio, sample_rate);
+    FileResult torch_file = bench_libtorch_file(jit_path, audio, sample_rate);
+    TorchBatchResult torch_batched = bench_libtorch_batched(jit_path,
+        std::vector<float>(audio.begin(), audio.begin() + std::min<size_t>(audio.size(), sample_rate * 20)),
+        sample_rate, 16);
+#endif
+
+    // ----- Report -----
+    FILE* out = json_path.empty() ? stdout : fopen(json_path.c_str(), "w");
+    if (out == NULL) {
+        fprintf(stderr, "Cannot write %s\n", json_path.c_str());
+        return 1;
+    }
+    fprintf(out, "{\n");
+    fprintf(out, "  \"audio_seconds\": %.1f,\n  \"sample_rate\": %d,\n  \"window_samples\": %d,\n  \"threads\": %d,\n",
+        seconds, sample_rate, window, threads);
+    print_latency(out, "onnx", onnx, false);
+#ifdef SILERO_VAD_STATS
+    // Per-stage breakdown of the single-stream run (built with -DSILERO_VAD_STATS).
+    fprintf(out, "  \"onnx_stages\": {");
+    for (int i = 0; i < VAD_STAGE_COUNT; i++) {
+        const LatencyHistogram& h = vad.stats().stage[i];
+        fprintf(out, "%s\"%s\": {\"mean_us\": %.2f, \"p50_us\": %.2f, \"p99_us\": %.2f}", i ? ", " : "",
+            vad_stage_name(i), h.mean_ns() / 1e3, h.percentile_ns(0.50) / 1e3, h.percentile_ns(0.99) / 1e3);
+    }
+    fprintf(out, "},\n");
+#endif
+    fprintf(out, "  \"onnx_scheduler\": {\"streams\": %d, \"windows_per_sec\": %.1f, \"windows_per_sec_per_core\": %.1f},\n",
+        num_streams, sched_wps, sched_wps / threads);
+    fprintf(out, "  \"streams\": {\"created\": %d, \"create_us\": %.2f, \"rss_kb_per_stream\": %.2f},\n",
+        created_streams, create_us, rss_per_stream_kb);
+    fprintf(out, "  \"input_rates\": {");
+    for (size_t i = 0; i < rates.size(); i++) {
+        fprintf(out, "%s\"%d\": {\"model_rate\": %d, \"resample_x_realtime\": %.1f, \"rtf\": %.6f}",
+            i ? ", " : "", rates[i].input_rate, rates[i].model_rate, rates[i].resample_x_realtime, rates[i].rtf);
+    }
+    fprintf(out, "},\n");
+#ifdef SILERO_BENCH_LIBTORCH
+    print_latency(out, "libtorch", torch, false);
+    fprintf(out, "  \"libtorch_file\": {\"windows\": %zu, \"rtf\": %.6f, \"windows_per_sec\": %.1f, "
+        "\"allocs_per_window\": %.3f},\n",
+        torch_file.windows, torch_file.rtf, torch_file.windows_per_sec, torch_file.allocs_per_window);
+    fprintf(out, "  \"libtorch_batched\": {\"streams\": %d, \"windows_per_sec\": %.1f, \"sequential_windows_per_sec\": %.1f, "
+        "\"use_batch_windows_per_sec\": %.1f, \"max_prob_diff\": %.2e},\n",
+        torch_batched.streams, torch_batched.windows_per_sec, torch_batched.sequential_windows_per_sec,
+        torch_batched.use_batch_windows_per_sec, torch_batched.max_prob_diff);
+#endif
+    fprintf(out, "  \"wav\": {\"megabytes\": %.1f, \"wavreader_open_mb_per_sec\": %.1f, \"mmap_read_mb_per_sec\": %.1f, "
+        "\"stream_read_mb_per_sec\": %.1f, \"open_to_first_prob_ms\": %.3f},\n",
+        wav_mb, open_mbps, mmap_mbps, stream_mbps, first_prob_ms);
+    fprintf(out, "  \"peak_rss_mb\": %.1f\n}\n", peak_rss_mb());
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
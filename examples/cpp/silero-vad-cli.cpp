@@ -0,0 +1,367 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Batch VAD over directories and file lists.
+//
+// Inputs are WAV files found (recursively) under --dir and the paths listed in --manifest
+// files (one per line, blank lines and lines starting with '#' are skipped, "-" reads the
+// list from stdin); both options can be repeated. The files are sorted by size, largest
+// first, so long files do not end up last on one worker. They then run through VadPipeline:
+// decoder threads, --workers inference threads sharing one model, and one writer. Files are
+// streamed in blocks; at most --prefetch decoded samples per queued file are held ahead of
+// the workers, so memory does not grow with file length.
+//
+// Timestamps (seconds) are written to --output (default stdout) through a buffered writer:
+//   jsonl : {"file": ..., "duration": ..., "channels": ..., "segments": [{"channel", "start", "end"}]}
+//           per file; failed files get {"file": ..., "error": ...}
+//   rttm  : SPEAKER <file-id> <channel> <onset> <duration> <NA> <NA> speech <NA> <NA>
+//           per segment (file-id: file name without extension; channels from 1)
+// Failed files are listed on stderr, followed by a JSON report: files, failures, audio
+// hours, files/sec and audio hours/sec. The exit status is 2 if any file failed and 1 on a
+// usage error.
+//
+// Usage: ./silero-vad-cli [--dir DIR]... [--manifest LIST]... [--output FILE] [--format jsonl|rttm]
+//                         [--model silero_vad.onnx] [--workers N] [--decode-threads N] [--queue N]
+//                         [--prefetch 1048576] [--sort size|none] [--sample-rate 16000] [--threshold 0.5]
+//                         [--min-speech-ms 250] [--min-silence-ms 100] [--speech-pad-ms 30]
+//                         [--max-speech-s inf]
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "silero-vad-pipeline.h"
+
+namespace {
+
+namespace fs = std::filesystem;
+
+struct InputFile {
+    std::string path;
+    uint64_t bytes = 0;
+};
+
+bool is_wav(const fs::path& p) {
+    std::string ext = p.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".wav";
+}
+
+// Option values: the whole string must parse, counts must not be negative. Anything else
+// throws std::invalid_argument (or std::out_of_range).
+size_t parse_count(const std::string& s) {
+    size_t end = 0;
+    long long v = std::stoll(s, &end);
+    if (end != s.size() || v < 0)
+        throw std::invalid_argument(s);
+    return static_cast<size_t>(v);
+}
+
+int parse_int(const std::string& s) {
+    size_t end = 0;
+    int v = std::stoi(s, &end);
+    if (end != s.size())
+        throw std::invalid_argument(s);
+    return v;
+}
+
+float parse_float(const std::string& s) {
+    size_t end = 0;
+    float v = std::stof(s, &end);
+    if (end != s.size())
+        throw std::invalid_argument(s);
+    return v;
+}
+
+// Appends every WAV file under dir. Unreadable subdirectories are skipped.
+bool list_directory(const std::string& dir, std::vector<InputFile>& out) {
+    std::error_code ec;
+    fs::recursive_directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec);
+    if (ec) {
+        fprintf(stderr, "%s: %s\n", dir.c_str(), ec.message().c_str());
+        return false;
+    }
+    for (fs::recursive_directory_iterator end; it != end; it.increment(ec)) {
+        if (ec) {
+            ec.clear();
+            continue;
+        }
+        if (!it->is_regular_file(ec) || !is_wav(it->path()))
+            continue;
+        InputFile f;
+        f.path = it->path().string();
+        f.bytes = it->file_size(ec);
+        out.push_back(std::move(f));
+    }
+    return true;
+}
+
+// Appends the paths listed in a manifest ("-": stdin).
+bool read_manifest(const std::string& manifest, std::vector<InputFile>& out) {
+    std::ifstream file;
+    if (manifest != "-") {
+        file.open(manifest);
+        if (!file) {
+            fprintf(stderr, "%s: cannot open manifest\n", manifest.c_str());
+            return false;
+        }
+    }
+    std::istream& in = manifest == "-" ? std::cin : file;
+    std::error_code ec;
+    for (std::string line; std::getline(in, line); ) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || line[0] == '#')
+            continue;
+        InputFile f;
+        f.path = line;
+        uintmax_t bytes = fs::file_size(line, ec);
+        f.bytes = ec ? 0 : bytes;
+        out.push_back(std::move(f));
+    }
+    return true;
+}
+
+// BufferedWriter class: formats output into a large buffer and writes it in big blocks,
+// so millions of small records cost few write calls.
+class BufferedWriter {
+private:
+    FILE* fp;
+    std::vector<char> buffer;
+    size_t used = 0;
+
+public:
+    explicit BufferedWriter(FILE* Fp, size_t capacity = 1 << 20) : fp(Fp), buffer(capacity) {}
+    ~BufferedWriter() { flush(); }
+
+    void flush() {
+        if (used > 0)
+            fwrite(buffer.data(), 1, used, fp);
+        used = 0;
+    }
+
+    void write(const char* data, size_t n) {
+        if (used + n > buffer.size()) {
+            flush();
+            if (n > buffer.size()) {
+                fwrite(data, 1, n, fp);
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + used, data, n);
+        used += n;
+    }
+
+    void write(const char* s) { write(s, std::strlen(s)); }
+    void write(const std::string& s) { write(s.data(), s.size()); }
+
+    void printf(const char* format, ...) {
+        for (int attempt = 0; attempt < 2; attempt++) {
+            va_list args;
+            va_start(args, format);
+            int n = vsnprintf(buffer.data() + used, buffer.size() - used, format, args);
+            va_end(args);
+            if (n < 0)
+                return;
+            if (used + n < buffer.size()) {
+                used += n;
+                return;
+            }
+            flush();
+            if (static_cast<size_t>(n) >= buffer.size())
+                buffer.resize(n + 1);
+        }
+    }
+};
+
+// Escapes a string for a JSON string literal.
+std::string json_escape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size() + 2);
+    for (char c : s) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char hex[8];
+                snprintf(hex, sizeof(hex), "\\u%04x", c);
+                out += hex;
+            } else {
+                out += c;
+            }
+        }
+    }
+    return out;
+}
+
+void write_jsonl(BufferedWriter& out, const VadFileResult& r, int sample_rate) {
+    out.write("{\"file\": \"");
+    out.write(json_escape(r.path));
+    if (!r.ok()) {
+        out.write("\", \"error\": \"");
+        out.write(json_escape(r.error));
+        out.write("\"}\n");
+        return;
+    }
+    out.printf("\", \"duration\": %.3f, \"channels\": %d, \"segments\": [", r.audio_seconds, r.num_channels);
+    bool first = true;
+    for (size_t c = 0; c < r.speech.size(); c++) {
+        for (const timestamp_t& ts : r.speech[c]) {
+            out.printf("%s{\"channel\": %zu, \"start\": %.3f, \"end\": %.3f}", first ? "" : ", ", c,
+                static_cast<double>(ts.start) / sample_rate, static_cast<double>(ts.end) / sample_rate);
+            first = false;
+        }
+    }
+    out.write("]}\n");
+}
+
+void write_rttm(BufferedWriter& out, const VadFileResult& r, int sample_rate) {
+    const std::string id = fs::path(r.path).stem().string();
+    for (size_t c = 0; c < r.speech.size(); c++) {
+        for (const timestamp_t& ts : r.speech[c]) {
+            out.printf("SPEAKER %s %zu %.3f %.3f <NA> <NA> speech <NA> <NA>\n", id.c_str(), c + 1,
+                static_cast<double>(ts.start) / sample_rate, static_cast<double>(ts.end - ts.start) / sample_rate);
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = "../../src/silero_vad/data/silero_vad.onnx";
+    std::vector<std::string> dirs, manifests;
+    std::string output = "-";
+    std::string format = "jsonl";
+    std::string sort = "size";
+    VadPipelineOptions options;
+    options.infer_threads = std::max(1u, std::thread::hardware_concurrency());
+    options.decode_threads = 0;
+    options.decoded_queue = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        std::string value = argv[i + 1];
+        try {
+            if (key == "--dir") dirs.push_back(value);
+            else if (key == "--manifest") manifests.push_back(value);
+            else if (key == "--output") output = value;
+            else if (key == "--format") format = value;
+            else if (key == "--model") model_arg = value;
+            else if (key == "--workers") options.infer_threads = std::max<size_t>(1, parse_count(value));
+            else if (key == "--decode-threads") options.decode_threads = parse_count(value);
+            else if (key == "--queue") options.decoded_queue = parse_count(value);
+            else if (key == "--prefetch") options.prefetch_samples = parse_count(value);
+            else if (key == "--sort") sort = value;
+            else if (key == "--sample-rate") options.sample_rate = parse_int(value);
+            else if (key == "--threshold") options.threshold = parse_float(value);
+            else if (key == "--min-speech-ms") options.min_speech_duration_ms = parse_int(value);
+            else if (key == "--min-silence-ms") options.min_silence_duration_ms = parse_int(value);
+            else if (key == "--speech-pad-ms") options.speech_pad_ms = parse_int(value);
+            else if (key == "--max-speech-s") options.max_speech_duration_s = parse_float(value);
+            else {
+                fprintf(stderr, "Unknown option %s\n", argv[i]);
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            fprintf(stderr, "Invalid value for %s: %s\n", argv[i], argv[i + 1]);
+            return 1;
+        }
+    }
+    if ((argc - 1) % 2 != 0) {
+        fprintf(stderr, "Missing value for %s\n", argv[argc - 1]);
+        return 1;
+    }
+    if (format != "jsonl" && format != "rttm") {
+        fprintf(stderr, "Unknown format %s (jsonl or rttm)\n", format.c_str());
+        return 1;
+    }
+    if (sort != "size" && sort != "none") {
+        fprintf(stderr, "Unknown sort %s (size or none)\n", sort.c_str());
+        return 1;
+    }
+    if (dirs.empty() && manifests.empty()) {
+        fprintf(stderr, "No input: give --dir and/or --manifest\n");
+        return 1;
+    }
+    // A few decoders keep many workers fed; a couple of files per worker are enough
+    // to hide the decode time of the next one. Each queued file holds at most --prefetch
+    // samples, so the queue costs about 2 * workers * prefetch * 4 bytes at most.
+    if (options.decode_threads == 0)
+        options.decode_threads = 1 + options.infer_threads / 8;
+    if (options.decoded_queue == 0)
+        options.decoded_queue = 2 * options.infer_threads;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<InputFile> inputs;
+    for (const std::string& d : dirs) {
+        if (!list_directory(d, inputs))
+            return 1;
+    }
+    for (const std::string& m : manifests) {
+        if (!read_manifest(m, inputs))
+            return 1;
+    }
+    if (sort == "size") {
+        std::stable_sort(inputs.begin(), inputs.end(),
+            [](const InputFile& a, const InputFile& b) { return a.bytes > b.bytes; });
+    }
+    std::vector<std::string> paths;
+    paths.reserve(inputs.size());
+    for (InputFile& f : inputs)
+        paths.push_back(std::move(f.path));
+    std::vector<InputFile>().swap(inputs);
+    const double scan_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    FILE* fp = output == "-" ? stdout : fopen(output.c_str(), "wb");
+    if (fp == NULL) {
+        fprintf(stderr, "%s: cannot open for writing\n", output.c_str());
+        return 1;
+    }
+    std::shared_ptr<VadModel> model = VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end()));
+    VadPipelineStats stats;
+    {
+        BufferedWriter out(fp);
+        VadPipeline pipeline(model, options);
+        const int sample_rate = options.sample_rate;
+        const bool rttm = format == "rttm";
+        stats = pipeline.run(paths, [&](const VadFileResult& r) {
+            if (!r.ok())
+                fprintf(stderr, "%s: %s\n", r.path.c_str(), r.error.c_str());
+            if (rttm)
+                write_rttm(out, r, sample_rate);
+            else
+                write_jsonl(out, r, sample_rate);
+        });
+    }
+    if (fp != stdout)
+        fclose(fp);
+    else
+        fflush(stdout);
+    for (const std::string& e : stats.emit_errors)
+        fprintf(stderr, "%s\n", e.c_str());
+
+    const double total_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double audio_hours = stats.audio_seconds / 3600.0;
+    fprintf(stderr, "{\"files\": %zu, \"failures\": %zu, \"audio_hours\": %.4f, \"scan_s\": %.3f, \"wall_s\": %.3f, "
+        "\"files_per_sec\": %.2f, \"audio_hours_per_sec\": %.5f, \"workers\": %zu, \"decode_threads\": %zu, "
+        "\"infer_utilization\": %.3f}\n",
+        stats.files, stats.failures, audio_hours, scan_s, total_s, stats.files / total_s, audio_hours / total_s,
+        options.infer_threads, options.decode_threads,
+        stats.wall_s > 0 ? stats.infer.busy_s / (stats.wall_s * options.infer_threads) : 0.0);
+    return stats.failures == 0 && stats.emit_errors.empty() ? 0 : 2;
+}
@@ -0,0 +1,132 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Measures cold start to the first speech probability for each way of loading the model:
+//
+//   file         : silero_vad.onnx from disk, full ORT_ENABLE_ALL optimization
+//   memory       : the same bytes read into a buffer first (as for models shipped in a blob)
+//   embedded     : bytes compiled into the binary (build with -DSILERO_VAD_EMBED_MODEL
+//                  -Wa,-I<dir of silero_vad.onnx>)
+//   cache_write  : first start with an optimized-graph cache: optimize and save it
+//   cache_onnx   : later starts loading the saved optimized graph (ONNX format)
+//   cache_ort    : later starts loading the saved optimized graph (ORT format)
+//
+// Each mode builds a fresh VadModel (bypassing the registry), creates a VadIterator and
+// runs one window. It is repeated --runs times, and the min and median are reported in
+// ms as JSON. The process-wide Ort::Env is created once, up front, and timed on its own.
+//
+// Usage: ./coldstart [--model silero_vad.onnx] [--runs 5]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-embedded.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct ModeResult {
+    std::string name;
+    double min_ms;
+    double median_ms;
+};
+
+// Loads a model with `load`, then creates an iterator and feeds one window; returns ms.
+double time_to_first_prob(const std::function<std::shared_ptr<VadModel>()>& load) {
+    std::vector<float> window(512, 0.0f);
+    Clock::time_point t = Clock::now();
+    VadIterator vad(load());
+    vad.feed(window.data(), window.size());
+    return std::chrono::duration<double>(Clock::now() - t).count() * 1e3;
+}
+
+ModeResult run_mode(const std::string& name, int runs, const std::function<std::shared_ptr<VadModel>()>& load,
+    const std::function<void()>& before_each = std::function<void()>()) {
+    std::vector<double> ms;
+    for (int i = 0; i < runs; i++) {
+        if (before_each)
+            before_each();
+        ms.push_back(time_to_first_prob(load));
+    }
+    std::sort(ms.begin(), ms.end());
+    ModeResult r = { name, ms.front(), ms[ms.size() / 2] };
+    return r;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = "../../src/silero_vad/data/silero_vad.onnx";
+    int runs = 5;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--model") model_arg = argv[i + 1];
+        else if (key == "--runs") runs = std::max(1, std::stoi(argv[i + 1]));
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    const std::basic_string<ORTCHAR_T> model_path(model_arg.begin(), model_arg.end());
+    const std::string cache_onnx = "silero_vad_coldstart.opt.onnx";
+    const std::string cache_ort = "silero_vad_coldstart.opt.ort";
+
+    // The shared Ort::Env is created on first use; time it separately.
+    Clock::time_point t = Clock::now();
+    VadModel warm(model_path);
+    const double first_model_ms = std::chrono::duration<double>(Clock::now() - t).count() * 1e3;
+
+    std::vector<ModeResult> results;
+    results.push_back(run_mode("file", runs, [&]() {
+        return std::make_shared<VadModel>(model_path);
+    }));
+
+    results.push_back(run_mode("memory", runs, [&]() {
+        std::ifstream f(model_arg, std::ios::binary | std::ios::ate);
+        std::vector<char> bytes(static_cast<size_t>(f.tellg()));
+        f.seekg(0);
+        f.read(bytes.data(), bytes.size());
+        return std::make_shared<VadModel>(bytes.data(), bytes.size());
+    }));
+
+#ifdef SILERO_VAD_EMBED_MODEL
+    results.push_back(run_mode("embedded", runs, [&]() {
+        return std::make_shared<VadModel>(embedded_model_data(), embedded_model_size());
+    }));
+#endif
+
+    VadModelOptions onnx_options, ort_options;
+    onnx_options.optimized_model_path.assign(cache_onnx.begin(), cache_onnx.end());
+    ort_options.optimized_model_path.assign(cache_ort.begin(), cache_ort.end());
+    // The files actually written carry the ONNX Runtime version and the model's identity.
+    const std::basic_string<ORTCHAR_T> cache_onnx_file = VadModel::optimized_cache_path(model_path, onnx_options);
+    const std::basic_string<ORTCHAR_T> cache_ort_file = VadModel::optimized_cache_path(model_path, ort_options);
+    results.push_back(run_mode("cache_write", runs, [&]() {
+        return std::make_shared<VadModel>(model_path, onnx_options);
+    }, [&]() { std::remove(std::string(cache_onnx_file.begin(), cache_onnx_file.end()).c_str()); }));
+    results.push_back(run_mode("cache_onnx", runs, [&]() {
+        return std::make_shared<VadModel>(model_path, onnx_options);
+    }));
+    std::make_shared<VadModel>(model_path, ort_options);  // writes the ORT-format cache
+    results.push_back(run_mode("cache_ort", runs, [&]() {
+        return std::make_shared<VadModel>(model_path, ort_options);
+    }));
+    std::remove(std::string(cache_onnx_file.begin(), cache_onnx_file.end()).c_str());
+    std::remove(std::string(cache_ort_file.begin(), cache_ort_file.end()).c_str());
+
+    printf("{\n  \"runs\": %d,\n  \"first_model_incl_env_ms\": %.3f,\n  \"modes\": {\n", runs, first_model_ms);
+    for (size_t i = 0; i < results.size(); i++) {
+        printf("    \"%s\": {\"min_ms\": %.3f, \"median_ms\": %.3f}%s\n", results[i].name.c_str(),
+            results[i].min_ms, results[i].median_ms, i + 1 < results.size() ? "," : "");
+    }
+    printf("  }\n}\n");
+    return 0;
+}
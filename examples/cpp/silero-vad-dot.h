@@ -0,0 +1,128 @@
+#ifndef SILERO_VAD_DOT_H_
+#define SILERO_VAD_DOT_H_
+
+// Float dot-product kernels with runtime CPU dispatch, shared by the native engine
+// (silero-vad-native.h) and the resampler (silero-vad-resampler.h).
+//
+// AVX2+FMA and SSE variants are compiled with function target attributes (see
+// pcm_convert.h), so no -mavx2 is needed. NEON is used when the compiler targets it.
+// The summation order differs between variants, so results agree to rounding only.
+
+#include "pcm_convert.h"  // CPU feature detection and target attributes
+
+namespace vad_dot {
+
+typedef float (*DotFn)(const float* a, const float* b, int n);
+
+inline float DotScalar(const float* a, const float* b, int n) {
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; i++)
+        s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+#ifdef PCM_CONVERT_X86
+PCM_TARGET("sse2")
+inline float DotSse(const float* a, const float* b, int n) {
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    acc0 = _mm_add_ps(acc0, acc1);
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc0);
+    float s = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; i++)
+        s += a[i] * b[i];
+    return s;
+}
+
+PCM_TARGET("avx2,fma")
+inline float DotAvx2(const float* a, const float* b, int n) {
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), acc3);
+    }
+    for (; i + 8 <= n; i += 8)
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    __m256 acc = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+    __m128 s4 = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    s4 = _mm_add_ps(s4, _mm_movehl_ps(s4, s4));
+    s4 = _mm_add_ss(s4, _mm_shuffle_ps(s4, s4, 1));
+    float s = _mm_cvtss_f32(s4);
+    for (; i < n; i++)
+        s += a[i] * b[i];
+    return s;
+}
+
+inline bool CpuHasAvx2Fma() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return pcm::CpuHasAvx2() && (info[2] & (1 << 12)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+#endif  // PCM_CONVERT_X86
+
+#ifdef PCM_CONVERT_NEON
+inline float DotNeon(const float* a, const float* b, int n) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f), acc1 = vdupq_n_f32(0.0f);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float32x2_t s2 = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    float s = vget_lane_f32(vpadd_f32(s2, s2), 0);
+    for (; i < n; i++)
+        s += a[i] * b[i];
+    return s;
+}
+#endif  // PCM_CONVERT_NEON
+
+struct DotKernel {
+    const char* name;
+    DotFn fn;
+};
+
+// The dot kernel selected for this CPU (detected once, thread-safe).
+inline const DotKernel& ActiveDot() {
+    static const DotKernel best = [] {
+#ifdef PCM_CONVERT_X86
+        if (CpuHasAvx2Fma()) {
+            DotKernel k = { "avx2", DotAvx2 };
+            return k;
+        }
+        DotKernel k = { "sse", DotSse };
+        return k;
+#elif defined(PCM_CONVERT_NEON)
+        DotKernel k = { "neon", DotNeon };
+        return k;
+#else
+        DotKernel k = { "scalar", DotScalar };
+        return k;
+#endif
+    }();
+    return best;
+}
+
+}  // namespace vad_dot
+
+#endif  // SILERO_VAD_DOT_H_
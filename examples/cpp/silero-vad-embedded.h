@@ -0,0 +1,74 @@
+#ifndef SILERO_VAD_EMBEDDED_H_
+#define SILERO_VAD_EMBEDDED_H_
+
+// Compiles silero_vad.onnx into the binary, so start-up needs no model file and no file I/O.
+//
+// Build with -DSILERO_VAD_EMBED_MODEL. The file is pulled in by the assembler (.incbin) at
+// compile time, from SILERO_VAD_MODEL_FILE (default: "silero_vad.onnx"). The assembler
+// resolves a relative name against its working directory (where the compiler was run),
+// then against its own include path, not against this header. So either pass the model's
+// directory to the assembler:
+//   -Wa,-I/path/to/src/silero_vad/data
+// or give the file with an absolute path:
+//   -DSILERO_VAD_MODEL_FILE='"/abs/path/silero_vad.onnx"'
+// Requires GCC or Clang. On ELF targets (Linux) the bytes go into a COMDAT section, so
+// including this header from several translation units still links one copy. On macOS,
+// include it from one translation unit only.
+
+#include <memory>
+#include <string>
+
+#include "silero-vad-onnx.h"
+
+#ifdef SILERO_VAD_EMBED_MODEL
+
+#ifndef SILERO_VAD_MODEL_FILE
+#define SILERO_VAD_MODEL_FILE "silero_vad.onnx"
+#endif
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#error "SILERO_VAD_EMBED_MODEL needs GCC or Clang (.incbin); load the model from a file or buffer instead"
+#endif
+
+#if defined(__APPLE__)
+#define SILERO_VAD_ASM_SYMBOL(name) "_" #name
+#define SILERO_VAD_ASM_BEGIN ".const_data\n"
+#define SILERO_VAD_ASM_LINKAGE(sym) ".globl " sym "\n"
+#define SILERO_VAD_ASM_END ".text\n"
+#else
+#define SILERO_VAD_ASM_SYMBOL(name) #name
+#define SILERO_VAD_ASM_BEGIN ".pushsection .rodata.silero_vad_model,\"aG\",@progbits,silero_vad_model,comdat\n"
+#define SILERO_VAD_ASM_LINKAGE(sym) ".weak " sym "\n"
+#define SILERO_VAD_ASM_END ".popsection\n"
+#endif
+
+__asm__(
+    SILERO_VAD_ASM_BEGIN
+    SILERO_VAD_ASM_LINKAGE(SILERO_VAD_ASM_SYMBOL(silero_vad_model_begin))
+    SILERO_VAD_ASM_LINKAGE(SILERO_VAD_ASM_SYMBOL(silero_vad_model_end))
+    ".balign 16\n"
+    SILERO_VAD_ASM_SYMBOL(silero_vad_model_begin) ":\n"
+    ".incbin \"" SILERO_VAD_MODEL_FILE "\"\n"
+    SILERO_VAD_ASM_SYMBOL(silero_vad_model_end) ":\n"
+    SILERO_VAD_ASM_END);
+
+extern "C" const unsigned char silero_vad_model_begin[];
+extern "C" const unsigned char silero_vad_model_end[];
+
+// The embedded model bytes.
+inline const unsigned char* embedded_model_data() {
+    return silero_vad_model_begin;
+}
+
+inline size_t embedded_model_size() {
+    return static_cast<size_t>(silero_vad_model_end - silero_vad_model_begin);
+}
+
+// Returns the shared model loaded from the embedded bytes (see VadModel::get()).
+inline std::shared_ptr<VadModel> embedded_vad_model(const VadModelOptions& options = VadModelOptions()) {
+    return VadModel::get("embedded:" SILERO_VAD_MODEL_FILE, embedded_model_data(), embedded_model_size(), options);
+}
+
+#endif  // SILERO_VAD_EMBED_MODEL
+
+#endif  // SILERO_VAD_EMBEDDED_H_
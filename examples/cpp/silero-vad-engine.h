@@ -0,0 +1,395 @@
+#ifndef SILERO_VAD_ENGINE_H_
+#define SILERO_VAD_ENGINE_H_
+
+#include <vector>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-native.h"
+#include "silero-vad-segmenter.h"
+#include "silero-vad-testaudio.h"
+#ifdef SILERO_VAD_LIBTORCH
+#include "../cpp_libtorch/silero_torch_batch.h"
+#endif
+
+// VadEngine class: inference for one stream, one window in and one speech probability out.
+// It holds the stream's context and recurrent state; the model behind it is shared.
+class VadEngine {
+public:
+    virtual ~VadEngine() { }
+
+    // Window length in samples: 512 at 16 kHz, 256 at 8 kHz.
+    virtual int window_samples() const = 0;
+
+    // Runs one window of window_samples() samples and returns its speech probability.
+    virtual float predict(const float* window) = 0;
+
+    // Clears the context and recurrent state for a new stream.
+    virtual void reset() = 0;
+};
+
+// VadBackend class: a loaded model with its runtime settings. It creates one engine per
+// stream and is shared by all of them.
+class VadBackend {
+public:
+    virtual ~VadBackend() { }
+
+    // Engine and configuration, e.g. "onnx(intra=2)" or "native(avx2)".
+    virtual std::string name() const = 0;
+
+    virtual bool supports(int sample_rate) const = 0;
+
+    virtual std::unique_ptr<VadEngine> create_engine(int sample_rate) const = 0;
+};
+
+// OnnxVadEngine class: ONNX Runtime inference on a shared VadModel, through the same
+// VadOrtIo buffers and tensors as VadIterator.
+class OnnxVadEngine : public VadEngine {
+private:
+    std::shared_ptr<VadModel> model;
+    VadOrtIo io;
+
+public:
+    OnnxVadEngine(std::shared_ptr<VadModel> Model, int sample_rate)
+        : model(std::move(Model)), io(*model, sample_rate, sample_rate == 8000 ? 256 : 512) { }
+
+    int window_samples() const override {
+        return io.window_samples();
+    }
+
+    float predict(const float* window) override {
+        std::memcpy(io.input() + io.context_samples(), window, io.window_samples() * sizeof(float));
+        io.run(*model);
+        io.advance();
+        return io.output();
+    }
+
+    void reset() override {
+        io.reset();
+    }
+};
+
+class OnnxVadBackend : public VadBackend {
+private:
+    std::shared_ptr<VadModel> model;
+    std::string label;
+
+public:
+    OnnxVadBackend(std::shared_ptr<VadModel> Model, const std::string& Label = "onnx")
+        : model(std::move(Model)), label(Label) { }
+
+    std::string name() const override {
+        return label;
+    }
+
+    bool supports(int sample_rate) const override {
+        return sample_rate == 16000 || (sample_rate == 8000 && model->num_inputs >= 3);
+    }
+
+    std::unique_ptr<VadEngine> create_engine(int sample_rate) const override {
+        return std::unique_ptr<VadEngine>(new OnnxVadEngine(model, sample_rate));
+    }
+};
+
+// NativeVadEngine class: the built-in kernels of silero-vad-native.h (no runtime).
+class NativeVadEngine : public VadEngine {
+private:
+    std::shared_ptr<const NativeVadModel> model;
+    const vad_native::Net* net;
+    vad_native::Scratch scratch;
+    std::vector<float> input;        // [context | window]
+    std::vector<float> _state;       // [h | c]
+
+public:
+    NativeVadEngine(std::shared_ptr<const NativeVadModel> Model, int sample_rate)
+        : model(std::move(Model))
+    {
+        net = model->net_for(sample_rate);
+        if (net == NULL)
+            throw std::invalid_argument("NativeVadEngine: the model has no weights for this sample rate");
+        input.assign(net->context + net->window, 0.0f);
+        _state.assign(2 * vad_native::kHidden, 0.0f);
+    }
+
+    int window_samples() const override {
+        return net->window;
+    }
+
+    float predict(const float* window) override {
+        std::memcpy(input.data() + net->context, window, net->window * sizeof(float));
+        float prob = vad_native::RunNet(*net, input.data(), _state.data(), scratch);
+        std::memmove(input.data(), input.data() + net->window, net->context * sizeof(float));
+        return prob;
+    }
+
+    void reset() override {
+        std::fill(input.begin(), input.end(), 0.0f);
+        std::fill(_state.begin(), _state.end(), 0.0f);
+    }
+};
+
+class NativeVadBackend : public VadBackend {
+private:
+    std::shared_ptr<const NativeVadModel> model;
+
+public:
+    explicit NativeVadBackend(std::shared_ptr<const NativeVadModel> Model)
+        : model(std::move(Model)) { }
+
+    std::string name() const override {
+        return std::string("native(") + vad_dot::ActiveDot().name + ")";
+    }
+
+    bool supports(int sample_rate) const override {
+        return model->supports(sample_rate);
+    }
+
+    std::unique_ptr<VadEngine> create_engine(int sample_rate) const override {
+        return std::unique_ptr<VadEngine>(new NativeVadEngine(model, sample_rate));
+    }
+};
+
+#ifdef SILERO_VAD_LIBTORCH
+// TorchVadEngine class: LibTorch inference through silero::BatchedVad with one stream,
+// which keeps the LSTM state and context explicitly.
+class TorchVadEngine : public VadEngine {
+private:
+    silero::BatchedVad vad;
+
+public:
+    TorchVadEngine(const std::string& jit_path, int sample_rate)
+        : vad(jit_path, 1, sample_rate) { }
+
+    int window_samples() const override {
+        return vad.WindowSize();
+    }
+
+    float predict(const float* window) override {
+        float prob;
+        vad.Process(window, &prob);
+        return prob;
+    }
+
+    void reset() override {
+        vad.Reset();
+    }
+};
+
+class TorchVadBackend : public VadBackend {
+private:
+    std::string jit_path;
+
+public:
+    explicit TorchVadBackend(const std::string& Jit_path)
+        : jit_path(Jit_path) { }
+
+    std::string name() const override {
+        return "libtorch";
+    }
+
+    bool supports(int sample_rate) const override {
+        return sample_rate == 16000 || sample_rate == 8000;
+    }
+
+    std::unique_ptr<VadEngine> create_engine(int sample_rate) const override {
+        return std::unique_ptr<VadEngine>(new TorchVadEngine(jit_path, sample_rate));
+    }
+};
+#endif
+
+// Vad class: speech segments on any VadBackend. Engines only produce probabilities;
+// segmentation is always VadSegmenter, so every backend reports timestamps in samples
+// with the same threshold, padding and min-speech rules as VadIterator and the Python
+// version.
+class Vad {
+private:
+    std::shared_ptr<const VadBackend> _backend;
+    std::unique_ptr<VadEngine> engine;
+    int window_size_samples;
+    std::vector<float> pending;      // Partial window carried to the next feed()
+    size_t pending_samples = 0;
+    int64_t audio_length_samples = 0;
+    float _output = 0.0f;
+    VadSegmenter segmenter;
+
+    void run(const float* window) {
+        _output = engine->predict(window);
+        segmenter.push(_output);
+    }
+
+public:
+    // The parameters after Sample_rate match VadIterator. The window is fixed by the model:
+    // 32 ms (512 samples at 16 kHz, 256 at 8 kHz).
+    Vad(std::shared_ptr<const VadBackend> Backend,
+        int Sample_rate = 16000, float Threshold = 0.5, int min_silence_duration_ms = 100,
+        int speech_pad_ms = 30, int min_speech_duration_ms = 250,
+        float max_speech_duration_s = std::numeric_limits<float>::infinity())
+        : _backend(std::move(Backend))
+    {
+        if (!_backend->supports(Sample_rate))
+            throw std::invalid_argument("Vad: " + _backend->name() + " does not support this sample rate");
+        engine = _backend->create_engine(Sample_rate);
+        window_size_samples = engine->window_samples();
+        pending.assign(window_size_samples, 0.0f);
+        segmenter = VadSegmenter(Sample_rate, window_size_samples, Threshold, min_silence_duration_ms,
+            speech_pad_ms, min_speech_duration_ms, max_speech_duration_s);
+    }
+
+    void process(const std::vector<float>& input_wav) {
+        process(input_wav.data(), input_wav.size());
+    }
+
+    void process(const float* input_wav, size_t num_samples) {
+        reset();
+        feed(input_wav, num_samples);
+        flush();
+    }
+
+    // See VadIterator::feed(). Whole windows are passed to the engine straight from
+    // `samples`; only a window split across calls is assembled in a buffer.
+    void feed(const float* samples, size_t num_samples) {
+        audio_length_samples += static_cast<int64_t>(num_samples);
+        size_t offset = 0;
+        if (pending_samples > 0) {
+            size_t take = std::min(num_samples, window_size_samples - pending_samples);
+            std::memcpy(pending.data() + pending_samples, samples, take * sizeof(float));
+            pending_samples += take;
+            offset += take;
+            if (pending_samples < static_cast<size_t>(window_size_samples))
+                return;
+            pending_samples = 0;
+            run(pending.data());
+        }
+        for (; num_samples - offset >= static_cast<size_t>(window_size_samples); offset += window_size_samples)
+            run(samples + offset);
+        pending_samples = num_samples - offset;
+        std::memcpy(pending.data(), samples + offset, pending_samples * sizeof(float));
+    }
+
+    // Ends the stream: closes an open speech segment. A trailing partial window is dropped.
+    void flush() {
+        segmenter.flush(audio_length_samples);
+    }
+
+    void set_speech_callbacks(std::function<void(int64_t)> on_start,
+        std::function<void(const timestamp_t&)> on_end) {
+        segmenter.set_speech_callbacks(std::move(on_start), std::move(on_end));
+    }
+
+    float last_speech_prob() const {
+        return _output;
+    }
+
+    const std::vector<timestamp_t>& get_speech_timestamps() const {
+        return segmenter.get_speech_timestamps();
+    }
+
+    void reset() {
+        engine->reset();
+        segmenter.reset();
+        pending_samples = 0;
+        audio_length_samples = 0;
+        _output = 0.0f;
+    }
+
+    const VadBackend& backend() const {
+        return *_backend;
+    }
+
+    int window_samples() const {
+        return window_size_samples;
+    }
+};
+
+// Calibration result of one candidate backend.
+struct VadCalibration {
+    std::string name;
+    double us_per_window;   // Median; infinity if the backend failed or lacks the sample rate.
+};
+
+// Times every candidate on `windows` windows of synthetic speech (after a few warm-up
+// windows) and returns the one with the lowest median time per window. Engine speed depends
+// on the CPU generation, the runtime build and the thread count, so this picks on the host
+// that will run the streams. It takes about windows x candidates x window time: a few
+// hundred milliseconds with the defaults. `report` receives every candidate's result in
+// order. Throws if windows is not positive or no candidate can run at sample_rate.
+inline std::shared_ptr<const VadBackend> select_vad_backend(
+    const std::vector<std::shared_ptr<const VadBackend>>& candidates, int sample_rate = 16000,
+    int windows = 200, std::vector<VadCalibration>* report = NULL) {
+    if (windows <= 0)
+        throw std::invalid_argument("select_vad_backend: windows must be positive");
+    typedef std::chrono::steady_clock Clock;
+    const int warmup = 10;
+    std::vector<float> audio = make_test_audio(sample_rate, (windows + warmup) * 0.032 + 0.1, 5);
+    std::shared_ptr<const VadBackend> best;
+    double best_us = std::numeric_limits<double>::infinity();
+    if (report)
+        report->clear();
+    for (const std::shared_ptr<const VadBackend>& candidate : candidates) {
+        double us = std::numeric_limits<double>::infinity();
+        if (candidate->supports(sample_rate)) {
+            try {
+                std::unique_ptr<VadEngine> engine = candidate->create_engine(sample_rate);
+                const int window = engine->window_samples();
+                std::vector<double> times;
+                for (int w = 0; w < warmup + windows; w++) {
+                    Clock::time_point t = Clock::now();
+                    engine->predict(audio.data() + static_cast<size_t>(w) * window);
+                    if (w >= warmup)
+                        times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t).count());
+                }
+                std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+                us = times[times.size() / 2];
+            } catch (const std::exception&) {
+                // Not usable on this host (e.g. missing kernels or device); skip it.
+            }
+        }
+        if (report)
+            report->push_back(VadCalibration{ candidate->name(), us });
+        if (us < best_us) {
+            best_us = us;
+            best = candidate;
+        }
+    }
+    if (!best)
+        throw std::runtime_error("select_vad_backend: no candidate runs at this sample rate");
+    return best;
+}
+
+// The usual candidates for a Silero VAD ONNX model: the native engine, ONNX Runtime with
+// 1, 2, 4, ... intra-op threads up to the hardware thread count, and LibTorch on jit_path
+// when built with -DSILERO_VAD_LIBTORCH. The native engine is left out if it cannot read
+// the model (e.g. the int8 export).
+inline std::vector<std::shared_ptr<const VadBackend>> default_vad_backends(
+    const std::string& onnx_path, const std::string& jit_path = "") {
+    std::vector<std::shared_ptr<const VadBackend>> backends;
+    try {
+        backends.push_back(std::make_shared<NativeVadBackend>(std::make_shared<NativeVadModel>(onnx_path)));
+    } catch (const std::exception&) {
+    }
+    const std::basic_string<ORTCHAR_T> path(onnx_path.begin(), onnx_path.end());
+    const int hardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= hardware; threads *= 2) {
+        backends.push_back(std::make_shared<OnnxVadBackend>(VadModel::get(path, VadModelOptions(threads, 1)),
+            "onnx(intra=" + std::to_string(threads) + ")"));
+        if (threads >= 8)
+            break;
+    }
+#ifdef SILERO_VAD_LIBTORCH
+    if (!jit_path.empty())
+        backends.push_back(std::make_shared<TorchVadBackend>(jit_path));
+#else
+    (void)jit_path;
+#endif
+    return backends;
+}
+
+#endif  // SILERO_VAD_ENGINE_H_
@@ -0,0 +1,196 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Speech-only audio extraction (SpeechExtractor) throughput.
+//
+// It runs the VAD over a WAV file (--wav, or a generated 16-bit 16 kHz file of --seconds),
+// then writes the speech-only file, the silence-removed file and one file per segment,
+// --runs times each, and reports the best time and MB/s of output for:
+//   collect_copy_file_range : collect_chunks() with copy_file_range()
+//   collect_mmap_write      : collect_chunks() with write() from the mapping
+//   drop                    : drop_chunks()
+//   save_segments           : save_chunks(), one file per segment
+//   collect_decode_encode   : decode to float, gather the segments, convert back to 16-bit
+//                             and write with WavWriter (what collect_chunks() + save_audio()
+//                             in Python do)
+// bytes_exact checks that the collected file's payload is exactly the source bytes of
+// the segments. Output is JSON.
+//
+// --timestamps FILE also writes the segments (samples at 16 kHz) as JSON for
+// extract_bench.py, which times the Python tools on the same file and segments.
+//
+// Usage: ./extract [--model silero_vad.onnx] [--wav file.wav] [--seconds 600] [--dir .]
+//                  [--runs 3] [--timestamps ts.json]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "silero-vad-extract.h"
+#include "silero-vad-onnx.h"
+#include "silero-vad-testaudio.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Best wall time of runs calls of f.
+double best_of(int runs, const std::function<void()>& f) {
+    double best = 1e30;
+    for (int r = 0; r < runs; r++) {
+        Clock::time_point t = Clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - t).count());
+    }
+    return best;
+}
+
+void print_result(const char* name, double seconds, double mb, bool last) {
+    printf("    \"%s\": {\"seconds\": %.4f, \"mb_per_sec\": %.1f}%s\n", name, seconds, mb / seconds, last ? "" : ",");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = "../../src/silero_vad/data/silero_vad.onnx";
+    std::string wav_path;
+    std::string dir = ".";
+    std::string timestamps_path;
+    double seconds = 600.0;
+    int runs = 3;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--model") model_arg = argv[i + 1];
+        else if (key == "--wav") wav_path = argv[i + 1];
+        else if (key == "--seconds") seconds = std::stod(argv[i + 1]);
+        else if (key == "--dir") dir = argv[i + 1];
+        else if (key == "--runs") runs = std::max(1, std::stoi(argv[i + 1]));
+        else if (key == "--timestamps") timestamps_path = argv[i + 1];
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    const int sample_rate = 16000;
+
+    const bool generated = wav_path.empty();
+    if (generated) {
+        wav_path = dir + "/silero_vad_extract_src.wav";
+        std::vector<float> audio = make_test_audio(sample_rate, seconds, 25);
+        for (float& v : audio)
+            v = std::max(-1.0f, std::min(1.0f, v)) * 32767.0f;
+        wav::WavWriter writer(audio.data(), static_cast<int>(audio.size()), 1, sample_rate, 16);
+        writer.Write(wav_path);
+    }
+
+    SpeechExtractor extractor(wav_path, sample_rate);
+    const wav::MmapWavReader& src = extractor.source();
+
+    // Timestamps from the VAD, fed from the mapping one block at a time.
+    std::vector<timestamp_t> speech;
+    {
+        VadIterator vad(VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end())));
+        vad.set_input_sample_rate(src.sample_rate());
+        std::vector<float> block(src.sample_rate());
+        for (size_t pos = 0; pos < src.num_samples(); pos += block.size()) {
+            size_t n = std::min(block.size(), src.num_samples() - pos);
+            src.ReadFloat(pos, n, block.data());
+            vad.feed(block.data(), n);
+        }
+        vad.flush();
+        speech = vad.get_speech_timestamps();
+    }
+    if (!timestamps_path.empty()) {
+        FILE* fp = fopen(timestamps_path.c_str(), "w");
+        if (fp == NULL) {
+            fprintf(stderr, "%s: cannot open for writing\n", timestamps_path.c_str());
+            return 1;
+        }
+        fprintf(fp, "[");
+        for (size_t i = 0; i < speech.size(); i++)
+            fprintf(fp, "%s{\"start\": %lld, \"end\": %lld}", i ? ", " : "",
+                static_cast<long long>(speech[i].start), static_cast<long long>(speech[i].end));
+        fprintf(fp, "]\n");
+        fclose(fp);
+    }
+
+    const size_t frame_bytes = static_cast<size_t>(src.num_channel()) * (src.bits_per_sample() / 8);
+    const std::vector<VadFrameRange> ranges = extractor.speech_ranges(speech);
+    size_t speech_frames = 0;
+    for (const VadFrameRange& r : ranges)
+        speech_frames += r.end - r.begin;
+    const double speech_mb = speech_frames * frame_bytes / 1e6;
+    const double silence_mb = (src.num_samples() - speech_frames) * frame_bytes / 1e6;
+
+    const std::string collect_path = dir + "/silero_vad_extract_speech.wav";
+    const std::string drop_path = dir + "/silero_vad_extract_silence.wav";
+    const std::string decode_path = dir + "/silero_vad_extract_decoded.wav";
+
+    extractor.set_use_copy_file_range(true);
+    double t_cfr = best_of(runs, [&]() { extractor.collect_chunks(speech, collect_path); });
+    extractor.set_use_copy_file_range(false);
+    double t_mmap = best_of(runs, [&]() { extractor.collect_chunks(speech, collect_path); });
+    extractor.set_use_copy_file_range(true);
+    double t_drop = best_of(runs, [&]() { extractor.drop_chunks(speech, drop_path); });
+    size_t segment_files = 0;
+    double t_split = best_of(runs, [&]() { segment_files = extractor.save_chunks(speech, dir, "silero_vad_extract"); });
+
+    // The float round trip, for mono 16-bit sources (what the Python path does).
+    double t_decode = 0.0;
+    const bool can_decode = src.num_channel() == 1 && src.bits_per_sample() == 16;
+    if (can_decode) {
+        t_decode = best_of(runs, [&]() {
+            std::vector<float> all(src.num_samples());
+            src.ReadFloat(0, src.num_samples(), all.data());
+            std::vector<float> out;
+            out.reserve(speech_frames);
+            for (const VadFrameRange& r : ranges)
+                out.insert(out.end(), all.begin() + r.begin, all.begin() + r.end);
+            for (float& v : out)
+                v *= 32768.0f;
+            wav::WavWriter writer(out.data(), static_cast<int>(out.size()), 1, src.sample_rate(), 16);
+            writer.Write(decode_path);
+        });
+    }
+
+    // The collected payload must be the source bytes of the segments, in order.
+    bool bytes_exact;
+    {
+        wav::MmapWavReader out(collect_path);
+        const uint8_t* a = static_cast<const uint8_t*>(out.pcm_data());
+        const uint8_t* b = static_cast<const uint8_t*>(src.pcm_data());
+        bytes_exact = out.pcm_bytes() == speech_frames * frame_bytes;
+        size_t pos = 0;
+        for (const VadFrameRange& r : ranges) {
+            const size_t n = (r.end - r.begin) * frame_bytes;
+            bytes_exact = bytes_exact && std::memcmp(a + pos, b + r.begin * frame_bytes, n) == 0;
+            pos += n;
+        }
+    }
+
+    std::remove(collect_path.c_str());
+    std::remove(drop_path.c_str());
+    std::remove(decode_path.c_str());
+    for (size_t i = 1; i <= segment_files; i++)
+        std::remove((dir + "/silero_vad_extract-" + std::to_string(i) + ".wav").c_str());
+    if (generated && timestamps_path.empty())
+        std::remove(wav_path.c_str());
+
+    printf("{\n  \"source\": {\"path\": \"%s\", \"seconds\": %.1f, \"channels\": %d, \"sample_rate\": %d, \"bits\": %d},\n",
+        wav_path.c_str(), static_cast<double>(src.num_samples()) / src.sample_rate(), src.num_channel(),
+        src.sample_rate(), src.bits_per_sample());
+    printf("  \"segments\": %zu,\n  \"speech_mb\": %.2f,\n  \"bytes_exact\": %s,\n  \"results\": {\n",
+        speech.size(), speech_mb, bytes_exact ? "true" : "false");
+    print_result("collect_copy_file_range", t_cfr, speech_mb, false);
+    print_result("collect_mmap_write", t_mmap, speech_mb, false);
+    print_result("drop", t_drop, silence_mb, false);
+    print_result("save_segments", t_split, speech_mb, !can_decode);
+    if (can_decode)
+        print_result("collect_decode_encode", t_decode, speech_mb, true);
+    printf("  }\n}\n");
+    return 0;
+}
@@ -0,0 +1,268 @@
+#ifndef SILERO_VAD_EXTRACT_H_
+#define SILERO_VAD_EXTRACT_H_
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "silero-vad-segmenter.h"
+#include "wav.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+// copy_file_range(2): Linux 4.5+, declared by glibc 2.27+.
+#if defined(__linux__) && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+#define SILERO_VAD_COPY_FILE_RANGE 1
+#endif
+
+// Frames [begin, end) of a WAV file.
+struct VadFrameRange {
+    size_t begin;
+    size_t end;
+};
+
+// SpeechExtractor class: writes the speech (or everything but the speech) of a WAV file to
+// new WAV files, like collect_chunks() / drop_chunks() in utils_vad.py, or one file per
+// segment like my-info/split_wav_based_on_vad.py.
+//
+// The samples are never decoded. Each output is a 44-byte header with the source format
+// followed by byte ranges copied from the source's data chunk: with copy_file_range() on
+// Linux (the kernel copies, or shares extents on filesystems that support it), otherwise
+// with write() / fwrite() straight from the memory-mapped source.
+//
+// Timestamps are in samples at the model rate, as VadIterator returns them; they are
+// scaled to the file's rate, so files that were resampled for the VAD are cut at the
+// matching positions. All channels of a frame are kept.
+class SpeechExtractor {
+private:
+    wav::MmapWavReader reader;
+    int model_rate;
+    size_t frame_bytes;
+    bool use_copy_file_range = true;
+#ifndef _WIN32
+    int source_fd = -1;
+#endif
+
+    size_t to_frames(int64_t samples) const {
+        if (samples <= 0)
+            return 0;
+        uint64_t frame = static_cast<uint64_t>(samples) * static_cast<uint64_t>(reader.sample_rate()) / model_rate;
+        return static_cast<size_t>(std::min<uint64_t>(frame, reader.num_samples()));
+    }
+
+    void write_header(std::vector<uint8_t>& header, uint64_t data_bytes) const {
+        const uint16_t tag = reader.format() == wav::PcmFormat::kFloat32 ? 3 : 1;
+        const uint16_t channels = static_cast<uint16_t>(reader.num_channel());
+        const uint32_t rate = static_cast<uint32_t>(reader.sample_rate());
+        const uint16_t bits = static_cast<uint16_t>(reader.bits_per_sample());
+        const uint16_t block = static_cast<uint16_t>(frame_bytes);
+        const uint32_t byte_rate = rate * block;
+        const uint32_t data_size = static_cast<uint32_t>(data_bytes);
+        const uint32_t riff_size = static_cast<uint32_t>(36 + data_bytes + (data_bytes & 1));
+        const uint32_t fmt_size = 16;
+        header.resize(44);
+        uint8_t* p = header.data();
+        std::memcpy(p, "RIFF", 4);
+        std::memcpy(p + 4, &riff_size, 4);
+        std::memcpy(p + 8, "WAVEfmt ", 8);
+        std::memcpy(p + 16, &fmt_size, 4);
+        std::memcpy(p + 20, &tag, 2);
+        std::memcpy(p + 22, &channels, 2);
+        std::memcpy(p + 24, &rate, 4);
+        std::memcpy(p + 28, &byte_rate, 4);
+        std::memcpy(p + 32, &block, 2);
+        std::memcpy(p + 34, &bits, 2);
+        std::memcpy(p + 36, "data", 4);
+        std::memcpy(p + 40, &data_size, 4);
+    }
+
+#ifndef _WIN32
+    static void write_all(int fd, const uint8_t* data, size_t n, const std::string& out_path) {
+        while (n > 0) {
+            ssize_t done = ::write(fd, data, n);
+            if (done < 0 && errno == EINTR)
+                continue;
+            if (done <= 0)
+                throw std::runtime_error("SpeechExtractor: cannot write " + out_path);
+            data += done;
+            n -= static_cast<size_t>(done);
+        }
+    }
+
+    // Copies n bytes at offset of the source to the end of fd.
+    void copy_bytes(int fd, size_t offset, size_t n, const std::string& out_path) {
+#ifdef SILERO_VAD_COPY_FILE_RANGE
+        while (use_copy_file_range && n > 0) {
+            loff_t in = static_cast<loff_t>(offset);
+            ssize_t done = copy_file_range(source_fd, &in, fd, NULL, n, 0);
+            if (done < 0 && errno == EINTR)
+                continue;
+            if (done <= 0) {
+                // Not supported here (old kernel, cross-filesystem on older kernels, special
+                // files): fall back to writing from the mapping.
+                use_copy_file_range = false;
+                break;
+            }
+            offset += static_cast<size_t>(done);
+            n -= static_cast<size_t>(done);
+        }
+#endif
+        const uint8_t* base = static_cast<const uint8_t*>(reader.pcm_data()) - reader.pcm_offset();
+        write_all(fd, base + offset, n, out_path);
+    }
+#endif
+
+    // Writes a WAV file holding the given frame ranges of the source, in order.
+    size_t write_ranges(const std::vector<VadFrameRange>& ranges, const std::string& out_path) {
+        uint64_t frames = 0;
+        for (const VadFrameRange& r : ranges)
+            frames += r.end - r.begin;
+        const uint64_t data_bytes = frames * frame_bytes;
+        if (data_bytes + 36 + 1 > UINT32_MAX)
+            throw std::runtime_error("SpeechExtractor: output exceeds the 4 GB WAV limit: " + out_path);
+        std::vector<uint8_t> header;
+        write_header(header, data_bytes);
+        const uint8_t pad = 0;
+#ifdef _WIN32
+        FILE* fp = fopen(out_path.c_str(), "wb");
+        if (fp == NULL)
+            throw std::runtime_error("SpeechExtractor: cannot create " + out_path);
+        bool ok = fwrite(header.data(), 1, header.size(), fp) == header.size();
+        const uint8_t* pcm = static_cast<const uint8_t*>(reader.pcm_data());
+        for (const VadFrameRange& r : ranges) {
+            const size_t n = (r.end - r.begin) * frame_bytes;
+            ok = ok && fwrite(pcm + r.begin * frame_bytes, 1, n, fp) == n;
+        }
+        if (data_bytes & 1)
+            ok = ok && fwrite(&pad, 1, 1, fp) == 1;
+        ok = fclose(fp) == 0 && ok;
+        if (!ok)
+            throw std::runtime_error("SpeechExtractor: cannot write " + out_path);
+#else
+        int fd = ::open(out_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            throw std::runtime_error("SpeechExtractor: cannot create " + out_path);
+        try {
+            write_all(fd, header.data(), header.size(), out_path);
+            for (const VadFrameRange& r : ranges)
+                copy_bytes(fd, reader.pcm_offset() + r.begin * frame_bytes, (r.end - r.begin) * frame_bytes, out_path);
+            if (data_bytes & 1)
+                write_all(fd, &pad, 1, out_path);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        if (::close(fd) != 0)
+            throw std::runtime_error("SpeechExtractor: cannot write " + out_path);
+#endif
+        return static_cast<size_t>(frames);
+    }
+
+public:
+    // Opens the source. model_sample_rate is the rate of the timestamps (the VAD's rate).
+    explicit SpeechExtractor(const std::string& path, int model_sample_rate = 16000)
+        : model_rate(model_sample_rate)
+    {
+        if (model_rate <= 0)
+            throw std::invalid_argument("SpeechExtractor: model_sample_rate must be positive");
+        if (!reader.Open(path))
+            throw std::runtime_error("SpeechExtractor: cannot read WAV file " + path);
+        frame_bytes = static_cast<size_t>(reader.num_channel()) * (reader.bits_per_sample() / 8);
+#ifndef _WIN32
+        source_fd = ::open(path.c_str(), O_RDONLY);
+        if (source_fd < 0)
+            use_copy_file_range = false;
+#endif
+    }
+
+    ~SpeechExtractor() {
+#ifndef _WIN32
+        if (source_fd >= 0)
+            ::close(source_fd);
+#endif
+    }
+
+    SpeechExtractor(const SpeechExtractor&) = delete;
+    SpeechExtractor& operator=(const SpeechExtractor&) = delete;
+
+    // Source frame ranges of the timestamps: scaled to the file rate, clipped to the file,
+    // sorted, with overlapping or touching ranges merged.
+    std::vector<VadFrameRange> speech_ranges(const std::vector<timestamp_t>& tss) const {
+        std::vector<VadFrameRange> ranges;
+        for (const timestamp_t& ts : tss) {
+            VadFrameRange r = { to_frames(ts.start), to_frames(ts.end) };
+            if (r.end > r.begin)
+                ranges.push_back(r);
+        }
+        std::sort(ranges.begin(), ranges.end(),
+            [](const VadFrameRange& a, const VadFrameRange& b) { return a.begin < b.begin; });
+        std::vector<VadFrameRange> merged;
+        for (const VadFrameRange& r : ranges) {
+            if (!merged.empty() && r.begin <= merged.back().end)
+                merged.back().end = std::max(merged.back().end, r.end);
+            else
+                merged.push_back(r);
+        }
+        return merged;
+    }
+
+    // The frames not covered by speech_ranges(tss).
+    std::vector<VadFrameRange> silence_ranges(const std::vector<timestamp_t>& tss) const {
+        std::vector<VadFrameRange> gaps;
+        size_t pos = 0;
+        for (const VadFrameRange& r : speech_ranges(tss)) {
+            if (r.begin > pos)
+                gaps.push_back(VadFrameRange{ pos, r.begin });
+            pos = r.end;
+        }
+        if (pos < reader.num_samples())
+            gaps.push_back(VadFrameRange{ pos, reader.num_samples() });
+        return gaps;
+    }
+
+    // Writes the speech segments, concatenated, to out_path. Returns the frames written.
+    size_t collect_chunks(const std::vector<timestamp_t>& tss, const std::string& out_path) {
+        return write_ranges(speech_ranges(tss), out_path);
+    }
+
+    // Writes the audio without the speech segments to out_path. Returns the frames written.
+    // Unlike drop_chunks() in utils_vad.py, the audio after the last segment is kept.
+    size_t drop_chunks(const std::vector<timestamp_t>& tss, const std::string& out_path) {
+        return write_ranges(silence_ranges(tss), out_path);
+    }
+
+    // Writes every segment to its own file, <out_dir>/<prefix>-<n>.wav with n from 1 in
+    // timestamp order (the naming of split_wav_based_on_vad.py). Returns the files written.
+    size_t save_chunks(const std::vector<timestamp_t>& tss, const std::string& out_dir,
+        const std::string& prefix = "speech") {
+        size_t n = 0;
+        std::vector<VadFrameRange> one(1);
+        for (const timestamp_t& ts : tss) {
+            one[0] = VadFrameRange{ to_frames(ts.start), to_frames(ts.end) };
+            if (one[0].end < one[0].begin)
+                one[0].end = one[0].begin;
+            write_ranges(one, out_dir + "/" + prefix + "-" + std::to_string(++n) + ".wav");
+        }
+        return n;
+    }
+
+    // Copies through user space from the mapping even where copy_file_range() is available
+    // (for comparison).
+    void set_use_copy_file_range(bool use) {
+#ifndef _WIN32
+        use_copy_file_range = use && source_fd >= 0;
+#else
+        (void)use;
+#endif
+    }
+
+    const wav::MmapWavReader& source() const { return reader; }
+};
+
+#endif  // SILERO_VAD_EXTRACT_H_
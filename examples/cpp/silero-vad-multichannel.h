@@ -0,0 +1,106 @@
+#ifndef SILERO_VAD_MULTICHANNEL_H_
+#define SILERO_VAD_MULTICHANNEL_H_
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include <functional>
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-batch.h"
+#include "pcm_convert.h"
+
+// MultiChannelVad class: independent voice activity detection for every channel of a
+// multichannel signal, e.g. the agent and customer sides of a split-channel call recording.
+//
+// Interleaved input is split per channel with the SIMD kernels from pcm_convert.h. Each
+// channel is a VadStream with its own context, LSTM state and segments. The next windows
+// of all channels run in one batched Session::Run through a BatchedVadEngine, so a stereo
+// file costs one inference call per window position rather than two.
+class MultiChannelVad {
+private:
+    BatchedVadEngine engine;
+    std::vector<VadStream> streams;
+    std::vector<VadStream*> stream_ptrs;
+
+    // Per-channel scratch for deinterleaving (grown to the largest block fed).
+    std::vector<std::vector<float>> planes;
+    std::vector<float*> plane_ptrs;
+
+    void reserve_planes(size_t num_frames) {
+        if (!planes.empty() && planes[0].size() >= num_frames)
+            return;
+        for (size_t c = 0; c < planes.size(); c++) {
+            planes[c].resize(num_frames);
+            plane_ptrs[c] = planes[c].data();
+        }
+    }
+
+public:
+    // The parameters after num_channels match VadIterator. Every channel uses the same
+    // settings.
+    MultiChannelVad(std::shared_ptr<VadModel> Model, int num_channels,
+        int Sample_rate = 16000, int windows_frame_size = 32,
+        float Threshold = 0.5, int min_silence_duration_ms = 100,
+        int speech_pad_ms = 30, int min_speech_duration_ms = 250,
+        float max_speech_duration_s = std::numeric_limits<float>::infinity())
+        : engine(std::move(Model), static_cast<size_t>(num_channels > 0 ? num_channels : 1), Sample_rate,
+            windows_frame_size)
+    {
+        if (num_channels <= 0)
+            throw std::invalid_argument("MultiChannelVad: num_channels must be positive");
+        streams.assign(num_channels, VadStream(Sample_rate, windows_frame_size, Threshold,
+            min_silence_duration_ms, speech_pad_ms, min_speech_duration_ms, max_speech_duration_s));
+        for (VadStream& s : streams)
+            stream_ptrs.push_back(&s);
+        planes.resize(num_channels);
+        plane_ptrs.resize(num_channels);
+    }
+
+    int num_channels() const {
+        return static_cast<int>(streams.size());
+    }
+
+    // Feeds num_frames interleaved frames (num_channels() samples each) and runs every
+    // window that is complete on all channels.
+    void feed_interleaved(const float* frames, size_t num_frames) {
+        reserve_planes(num_frames);
+        pcm::Deinterleave(frames, num_channels(), plane_ptrs.data(), num_frames);
+        feed_planar(plane_ptrs.data(), num_frames);
+    }
+
+    // Feeds num_frames samples of every channel, one buffer per channel.
+    void feed_planar(const float* const* channels, size_t num_frames) {
+        for (size_t c = 0; c < streams.size(); c++)
+            streams[c].feed(channels[c], num_frames);
+        engine.run(stream_ptrs.data(), stream_ptrs.size());
+    }
+
+    // Ends the stream on every channel (closes open segments).
+    void flush() {
+        for (VadStream& s : streams)
+            s.flush();
+    }
+
+    void reset() {
+        for (VadStream& s : streams)
+            s.reset();
+    }
+
+    // Live segment events of one channel (see VadIterator::set_speech_callbacks()).
+    void set_speech_callbacks(int channel, std::function<void(int64_t)> on_start,
+        std::function<void(const timestamp_t&)> on_end) {
+        streams.at(channel).set_speech_callbacks(std::move(on_start), std::move(on_end));
+    }
+
+    // Speech timestamps of one channel, in samples.
+    const std::vector<timestamp_t>& get_speech_timestamps(int channel) const {
+        return streams.at(channel).get_speech_timestamps();
+    }
+
+    VadStream& channel(int c) { return streams.at(c); }
+    const VadStream& channel(int c) const { return streams.at(c); }
+};
+
+#endif  // SILERO_VAD_MULTICHANNEL_H_
@@ -0,0 +1,121 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Per-window latency of the native engine (silero-vad-native.h) and, when built with
+// -DSILERO_BENCH_ONNX, of ONNX Runtime on the same model and audio, plus the agreement
+// between the two:
+//
+//   native / onnx : per-window latency p50/p99/max and windows/sec (one core)
+//   parity        : max / mean absolute probability difference and the share of windows
+//                   on the same side of the 0.5 threshold
+//
+// Without -DSILERO_BENCH_ONNX it needs no ONNX Runtime at all. Output is JSON.
+//
+// Usage: ./native_bench [--model silero_vad.onnx] [--seconds 60] [--sample-rate 16000]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "silero-vad-native.h"
+#include "silero-vad-testaudio.h"
+#ifdef SILERO_BENCH_ONNX
+#include "silero-vad-onnx.h"
+#endif
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Run {
+    std::vector<float> probs;
+    std::vector<double> latency_us;
+    double windows_per_sec = 0;
+};
+
+// Feeds the audio one window at a time, timing every window and keeping every probability.
+template <typename Iterator>
+Run run_windows(Iterator& vad, const std::vector<float>& audio, int window) {
+    Run run;
+    for (size_t i = 0; i + window <= audio.size() && i < static_cast<size_t>(window) * 100; i += window)
+        vad.feed(audio.data() + i, window);
+    vad.reset();
+
+    run.probs.reserve(audio.size() / window);
+    run.latency_us.reserve(audio.size() / window);
+    Clock::time_point total = Clock::now();
+    for (size_t i = 0; i + window <= audio.size(); i += window) {
+        Clock::time_point t = Clock::now();
+        vad.feed(audio.data() + i, window);
+        run.latency_us.push_back(std::chrono::duration<double>(Clock::now() - t).count() * 1e6);
+        run.probs.push_back(vad.last_speech_prob());
+    }
+    run.windows_per_sec = run.probs.size() / std::chrono::duration<double>(Clock::now() - total).count();
+    return run;
+}
+
+double percentile(std::vector<double> v, double p) {
+    std::sort(v.begin(), v.end());
+    return v[static_cast<size_t>(p * (v.size() - 1) + 0.5)];
+}
+
+void print_run(const char* name, const Run& r, bool last) {
+    printf("  \"%s\": {\"windows\": %zu, \"latency_us\": {\"p50\": %.2f, \"p99\": %.2f, \"max\": %.2f}, "
+        "\"windows_per_sec\": %.1f}%s\n",
+        name, r.probs.size(), percentile(r.latency_us, 0.50), percentile(r.latency_us, 0.99),
+        percentile(r.latency_us, 1.0), r.windows_per_sec, last ? "" : ",");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = "../../src/silero_vad/data/silero_vad.onnx";
+    double seconds = 60.0;
+    int sample_rate = 16000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--model") model_arg = argv[i + 1];
+        else if (key == "--seconds") seconds = std::stod(argv[i + 1]);
+        else if (key == "--sample-rate") sample_rate = std::stoi(argv[i + 1]);
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    const int window = sample_rate / 1000 * 32;
+    std::vector<float> audio = make_test_audio(sample_rate, seconds, 1);
+
+    std::shared_ptr<NativeVadModel> native_model = std::make_shared<NativeVadModel>(model_arg);
+    NativeVadIterator native_vad(native_model, sample_rate);
+    Run native = run_windows(native_vad, audio, window);
+
+    printf("{\n  \"sample_rate\": %d,\n  \"window\": %d,\n  \"kernel\": \"%s\",\n", sample_rate, window,
+        vad_dot::ActiveDot().name);
+#ifdef SILERO_BENCH_ONNX
+    VadIterator onnx_vad(VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end())),
+        sample_rate, 32);
+    Run onnx = run_windows(onnx_vad, audio, window);
+
+    double max_err = 0.0, sum_err = 0.0;
+    size_t same_label = 0;
+    for (size_t w = 0; w < native.probs.size(); w++) {
+        double err = std::fabs(static_cast<double>(native.probs[w]) - onnx.probs[w]);
+        max_err = std::max(max_err, err);
+        sum_err += err;
+        same_label += (native.probs[w] >= 0.5f) == (onnx.probs[w] >= 0.5f);
+    }
+    print_run("native", native, false);
+    print_run("onnx", onnx, false);
+    printf("  \"speedup\": %.2f,\n", native.windows_per_sec / onnx.windows_per_sec);
+    printf("  \"parity\": {\"max_abs_err\": %.2e, \"mean_abs_err\": %.2e, \"label_agreement\": %.6f}\n",
+        max_err, sum_err / native.probs.size(), static_cast<double>(same_label) / native.probs.size());
+#else
+    print_run("native", native, true);
+#endif
+    printf("}\n");
+    return 0;
+}
@@ -0,0 +1,610 @@
+#ifndef SILERO_VAD_NATIVE_H_
+#define SILERO_VAD_NATIVE_H_
+
+// Runtime-free Silero VAD inference.
+//
+// NativeVadModel reads the weights straight from the shipped ONNX file (silero_vad.onnx,
+// silero_vad_16k_op15.onnx or silero_vad_half.onnx) and evaluates the graph with plain C++
+// and SIMD dot-product kernels. No libonnxruntime is needed. One window is:
+//
+//   input [context | window] -> reflect-pad right -> STFT conv (basis, stride hop)
+//   -> magnitude -> 4 x (conv k=3 pad=1 + ReLU) -> LSTM cell (128) -> ReLU
+//   -> conv 1x1 -> sigmoid
+//
+// That is about 0.7 M multiply-adds per 16 kHz window. Every layer is a dot product of a
+// contiguous weight row with a contiguous input column. Conv inputs are unrolled (im2col)
+// once per frame, and the LSTM input and recurrent weights are packed into one row per gate.
+// NativeVadIterator has the same interface as VadIterator (see silero-vad-onnx.h).
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "silero-vad-dot.h"
+#include "silero-vad-segmenter.h"
+
+namespace vad_native {
+
+// ----- Minimal ONNX (protobuf) reader -----
+// Only what is needed to pull float tensors out of Constant nodes and initializers,
+// including those inside If subgraphs.
+
+struct Tensor {
+    std::vector<int64_t> dims;
+    std::vector<float> data;
+};
+
+class ProtoReader {
+public:
+    ProtoReader(const uint8_t* begin, const uint8_t* end) : p(begin), end(end) { }
+
+    bool done() const { return p >= end; }
+
+    // Reads the next field key; returns false at the end of the message.
+    bool next(uint32_t& field, uint32_t& wire) {
+        if (p >= end)
+            return false;
+        uint64_t key = varint();
+        field = static_cast<uint32_t>(key >> 3);
+        wire = static_cast<uint32_t>(key & 7);
+        return true;
+    }
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p >= end)
+                throw std::runtime_error("NativeVadModel: truncated ONNX file");
+            uint8_t c = *p++;
+            v |= static_cast<uint64_t>(c & 0x7f) << shift;
+            if (!(c & 0x80))
+                return v;
+        }
+        throw std::runtime_error("NativeVadModel: bad varint in ONNX file");
+    }
+
+    // Length-delimited payload as a sub-reader.
+    ProtoReader bytes() {
+        uint64_t len = varint();
+        if (len > static_cast<uint64_t>(end - p))
+            throw std::runtime_error("NativeVadModel: truncated ONNX file");
+        ProtoReader sub(p, p + len);
+        p += len;
+        return sub;
+    }
+
+    uint32_t fixed32() {
+        if (end - p < 4)
+            throw std::runtime_error("NativeVadModel: truncated ONNX file");
+        uint32_t v;
+        memcpy(&v, p, 4);
+        p += 4;
+        return v;
+    }
+
+    void skip(uint32_t wire) {
+        switch (wire) {
+        case 0: varint(); break;
+        case 1: p += 8; break;
+        case 2: bytes(); break;
+        case 5: p += 4; break;
+        default: throw std::runtime_error("NativeVadModel: unsupported protobuf wire type");
+        }
+    }
+
+    std::string str() {
+        ProtoReader s = bytes();
+        return std::string(reinterpret_cast<const char*>(s.p), s.end - s.p);
+    }
+
+    const uint8_t* p;
+    const uint8_t* end;
+};
+
+inline float HalfToFloat(uint16_t h) {
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+    uint32_t exp = (h >> 10) & 0x1f, mant = h & 0x3ff, bits;
+    if (exp == 0) {
+        if (mant == 0) {
+            bits = sign;
+        } else {  // subnormal: renormalize
+            exp = 127 - 15 + 1;
+            while (!(mant & 0x400)) {
+                mant <<= 1;
+                exp--;
+            }
+            bits = sign | (exp << 23) | ((mant & 0x3ff) << 13);
+        }
+    } else if (exp == 31) {
+        bits = sign | 0x7f800000 | (mant << 13);
+    } else {
+        bits = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+    }
+    float f;
+    memcpy(&f, &bits, 4);
+    return f;
+}
+
+// Parses a TensorProto. Returns false for element types other than float/float16.
+inline bool ReadTensor(ProtoReader r, std::string& name, Tensor& t) {
+    enum { kFloat = 1, kFloat16 = 10 };
+    int data_type = 0;
+    std::vector<uint8_t> raw;
+    std::vector<uint32_t> int32_data;
+    uint32_t field, wire;
+    while (r.next(field, wire)) {
+        if (field == 1 && wire == 0) {
+            t.dims.push_back(static_cast<int64_t>(r.varint()));
+        } else if (field == 1 && wire == 2) {
+            ProtoReader d = r.bytes();
+            while (!d.done())
+                t.dims.push_back(static_cast<int64_t>(d.varint()));
+        } else if (field == 2 && wire == 0) {
+            data_type = static_cast<int>(r.varint());
+        } else if (field == 4 && wire == 2) {
+            ProtoReader d = r.bytes();
+            while (!d.done()) {
+                uint32_t bits = d.fixed32();
+                float f;
+                memcpy(&f, &bits, 4);
+                t.data.push_back(f);
+            }
+        } else if (field == 4 && wire == 5) {
+            uint32_t bits = r.fixed32();
+            float f;
+            memcpy(&f, &bits, 4);
+            t.data.push_back(f);
+        } else if (field == 5 && wire == 2) {
+            ProtoReader d = r.bytes();
+            while (!d.done())
+                int32_data.push_back(static_cast<uint32_t>(d.varint()));
+        } else if (field == 5 && wire == 0) {
+            int32_data.push_back(static_cast<uint32_t>(r.varint()));
+        } else if (field == 8 && wire == 2) {
+            name = r.str();
+        } else if (field == 9 && wire == 2) {
+            ProtoReader d = r.bytes();
+            raw.assign(d.p, d.end);
+        } else {
+            r.skip(wire);
+        }
+    }
+    if (data_type == kFloat) {
+        if (!raw.empty()) {
+            t.data.resize(raw.size() / 4);
+            memcpy(t.data.data(), raw.data(), t.data.size() * 4);
+        }
+    } else if (data_type == kFloat16) {
+        if (!raw.empty()) {
+            for (size_t i = 0; i + 1 < raw.size(); i += 2)
+                t.data.push_back(HalfToFloat(static_cast<uint16_t>(raw[i] | (raw[i + 1] << 8))));
+        } else {
+            for (uint32_t v : int32_data)
+                t.data.push_back(HalfToFloat(static_cast<uint16_t>(v)));
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Collects every float tensor of a GraphProto (initializers and Constant node values),
+// descending into subgraphs.
+inline void CollectTensors(ProtoReader graph, std::map<std::string, Tensor>& out) {
+    uint32_t field, wire;
+    while (graph.next(field, wire)) {
+        if (field == 5 && wire == 2) {  // initializer
+            std::string name;
+            Tensor t;
+            if (ReadTensor(graph.bytes(), name, t))
+                out[name] = t;
+        } else if (field == 1 && wire == 2) {  // node
+            ProtoReader node = graph.bytes();
+            std::string output, op_type;
+            std::vector<ProtoReader> attributes;
+            uint32_t nf, nw;
+            while (node.next(nf, nw)) {
+                if (nf == 2 && nw == 2 && output.empty())
+                    output = node.str();
+                else if (nf == 4 && nw == 2)
+                    op_type = node.str();
+                else if (nf == 5 && nw == 2)
+                    attributes.push_back(node.bytes());
+                else
+                    node.skip(nw);
+            }
+            for (ProtoReader& attr : attributes) {
+                uint32_t af, aw;
+                while (attr.next(af, aw)) {
+                    if (af == 5 && aw == 2 && op_type == "Constant") {  // value
+                        std::string ignored;
+                        Tensor t;
+                        if (ReadTensor(attr.bytes(), ignored, t))
+                            out[output] = t;
+                    } else if (af == 6 && aw == 2) {  // subgraph (If branches)
+                        CollectTensors(attr.bytes(), out);
+                    } else {
+                        attr.skip(aw);
+                    }
+                }
+            }
+        } else {
+            graph.skip(wire);
+        }
+    }
+}
+
+// ----- Network -----
+
+struct ConvLayer {
+    int in_channels = 0, out_channels = 0, stride = 1;
+    std::vector<float> weight;  // [out][in * 3]
+    std::vector<float> bias;    // [out]
+};
+
+// Weights and geometry for one sample rate.
+struct Net {
+    int sample_rate = 0;
+    int context = 0, window = 0;         // input = context + window samples
+    int filter_length = 0, hop = 0, pad = 0, bins = 0, frames = 0;
+    std::vector<float> basis;            // [2 * bins][filter_length]
+    ConvLayer encoder[4];
+    std::vector<float> lstm_weight;      // [512][256]: W_ih row | W_hh row, PyTorch gate order i, f, g, o
+    std::vector<float> lstm_bias;        // [512]: b_ih + b_hh
+    std::vector<float> decoder_weight;   // [128]
+    float decoder_bias = 0.0f;
+};
+
+const int kHidden = 128;
+
+inline const Tensor& Require(const std::map<std::string, Tensor>& tensors, const std::string& name,
+    std::initializer_list<int64_t> dims) {
+    std::map<std::string, Tensor>::const_iterator it = tensors.find(name);
+    if (it == tensors.end())
+        throw std::runtime_error("NativeVadModel: missing tensor " + name);
+    const Tensor& t = it->second;
+    size_t count = 1;
+    if (t.dims.size() != dims.size() || !std::equal(dims.begin(), dims.end(), t.dims.begin()))
+        throw std::runtime_error("NativeVadModel: unexpected shape for " + name);
+    for (int64_t d : dims)
+        count *= static_cast<size_t>(d);
+    if (t.data.size() != count)
+        throw std::runtime_error("NativeVadModel: unexpected size for " + name);
+    return t;
+}
+
+// Builds the network for the tensors sharing `prefix` (one If branch of the graph).
+inline Net BuildNet(const std::map<std::string, Tensor>& tensors, const std::string& prefix) {
+    Net net;
+    std::map<std::string, Tensor>::const_iterator basis_it = tensors.find(prefix + "stft.forward_basis_buffer");
+    const int64_t basis_rows = basis_it->second.dims.empty() ? 0 : basis_it->second.dims[0];
+    if (basis_rows == 258) {
+        net.sample_rate = 16000;
+        net.context = 64;
+        net.window = 512;
+        net.filter_length = 256;
+    } else if (basis_rows == 130) {
+        net.sample_rate = 8000;
+        net.context = 32;
+        net.window = 256;
+        net.filter_length = 128;
+    } else {
+        throw std::runtime_error("NativeVadModel: unknown STFT basis shape");
+    }
+    net.hop = net.filter_length / 2;
+    net.pad = net.filter_length / 4;
+    net.bins = net.filter_length / 2 + 1;
+    net.frames = (net.context + net.window + net.pad - net.filter_length) / net.hop + 1;
+    net.basis = Require(tensors, prefix + "stft.forward_basis_buffer", { 2 * net.bins, 1, net.filter_length }).data;
+
+    const int channels[5] = { net.bins, 128, 64, 64, 128 };
+    const int strides[4] = { 1, 2, 2, 1 };
+    for (int l = 0; l < 4; l++) {
+        std::string base = prefix + "encoder." + std::to_string(l) + ".reparam_conv.";
+        ConvLayer& conv = net.encoder[l];
+        conv.in_channels = channels[l];
+        conv.out_channels = channels[l + 1];
+        conv.stride = strides[l];
+        conv.weight = Require(tensors, base + "weight", { channels[l + 1], channels[l], 3 }).data;
+        conv.bias = Require(tensors, base + "bias", { channels[l + 1] }).data;
+    }
+
+    const Tensor& w_ih = Require(tensors, prefix + "decoder.rnn.weight_ih", { 4 * kHidden, kHidden });
+    const Tensor& w_hh = Require(tensors, prefix + "decoder.rnn.weight_hh", { 4 * kHidden, kHidden });
+    const Tensor& b_ih = Require(tensors, prefix + "decoder.rnn.bias_ih", { 4 * kHidden });
+    const Tensor& b_hh = Require(tensors, prefix + "decoder.rnn.bias_hh", { 4 * kHidden });
+    net.lstm_weight.resize(4 * kHidden * 2 * kHidden);
+    net.lstm_bias.resize(4 * kHidden);
+    for (int g = 0; g < 4 * kHidden; g++) {
+        float* row = net.lstm_weight.data() + g * 2 * kHidden;
+        memcpy(row, w_ih.data.data() + g * kHidden, kHidden * sizeof(float));
+        memcpy(row + kHidden, w_hh.data.data() + g * kHidden, kHidden * sizeof(float));
+        net.lstm_bias[g] = b_ih.data[g] + b_hh.data[g];
+    }
+    net.decoder_weight = Require(tensors, prefix + "decoder.decoder.2.weight", { 1, kHidden, 1 }).data;
+    net.decoder_bias = Require(tensors, prefix + "decoder.decoder.2.bias", { 1 }).data[0];
+    return net;
+}
+
+// Per-stream scratch memory for Net::run (allocated once).
+struct Scratch {
+    std::vector<float> padded, spectrum, act[4], column, xh, gates;
+};
+
+inline float Sigmoid(float x) {
+    return 1.0f / (1.0f + std::exp(-x));
+}
+
+// conv1d k=3 pad=1 + ReLU; in is [in_channels][in_len], out is [out_channels][out_len].
+inline int ConvRelu(const ConvLayer& conv, const float* in, int in_len, float* out, std::vector<float>& column,
+    vad_dot::DotFn dot) {
+    const int out_len = (in_len + 2 - 3) / conv.stride + 1;
+    const int k = conv.in_channels * 3;
+    column.resize(static_cast<size_t>(out_len) * k);
+    for (int t = 0; t < out_len; t++) {
+        float* col = column.data() + t * k;
+        for (int c = 0; c < conv.in_channels; c++) {
+            for (int j = 0; j < 3; j++) {
+                int x = t * conv.stride + j - 1;
+                col[c * 3 + j] = (x >= 0 && x < in_len) ? in[c * in_len + x] : 0.0f;
+            }
+        }
+    }
+    for (int o = 0; o < conv.out_channels; o++) {
+        const float* w = conv.weight.data() + o * k;
+        for (int t = 0; t < out_len; t++) {
+            float v = conv.bias[o] + dot(w, column.data() + t * k, k);
+            out[o * out_len + t] = v > 0.0f ? v : 0.0f;
+        }
+    }
+    return out_len;
+}
+
+// One window: input holds context + window samples, state is [h(128) | c(128)] and is
+// updated in place. Returns the speech probability.
+inline float RunNet(const Net& net, const float* input, float* state, Scratch& s) {
+    vad_dot::DotFn dot = vad_dot::ActiveDot().fn;
+    const int len = net.context + net.window;
+
+    // Reflect padding on the right.
+    s.padded.resize(len + net.pad);
+    memcpy(s.padded.data(), input, len * sizeof(float));
+    for (int j = 0; j < net.pad; j++)
+        s.padded[len + j] = input[len - 2 - j];
+
+    // STFT as a strided convolution with the (real | imaginary) basis, then magnitude.
+    s.spectrum.resize(static_cast<size_t>(net.bins) * net.frames);
+    for (int b = 0; b < net.bins; b++) {
+        const float* re_row = net.basis.data() + b * net.filter_length;
+        const float* im_row = net.basis.data() + (net.bins + b) * net.filter_length;
+        for (int f = 0; f < net.frames; f++) {
+            const float* frame = s.padded.data() + f * net.hop;
+            float re = dot(re_row, frame, net.filter_length);
+            float im = dot(im_row, frame, net.filter_length);
+            s.spectrum[b * net.frames + f] = std::sqrt(re * re + im * im);
+        }
+    }
+
+    // Encoder
+    const float* x = s.spectrum.data();
+    int x_len = net.frames;
+    for (int l = 0; l < 4; l++) {
+        s.act[l].resize(static_cast<size_t>(net.encoder[l].out_channels) * x_len);
+        x_len = ConvRelu(net.encoder[l], x, x_len, s.act[l].data(), s.column, dot);
+        x = s.act[l].data();
+    }
+    // x is now [128][1].
+
+    // LSTM cell over [x | h]
+    s.xh.resize(2 * kHidden);
+    s.gates.resize(4 * kHidden);
+    memcpy(s.xh.data(), x, kHidden * sizeof(float));
+    memcpy(s.xh.data() + kHidden, state, kHidden * sizeof(float));
+    for (int g = 0; g < 4 * kHidden; g++)
+        s.gates[g] = net.lstm_bias[g] + dot(net.lstm_weight.data() + g * 2 * kHidden, s.xh.data(), 2 * kHidden);
+    float* h = state;
+    float* c = state + kHidden;
+    for (int j = 0; j < kHidden; j++) {
+        float i_gate = Sigmoid(s.gates[j]);
+        float f_gate = Sigmoid(s.gates[kHidden + j]);
+        float g_gate = std::tanh(s.gates[2 * kHidden + j]);
+        float o_gate = Sigmoid(s.gates[3 * kHidden + j]);
+        c[j] = f_gate * c[j] + i_gate * g_gate;
+        h[j] = o_gate * std::tanh(c[j]);
+    }
+
+    // Decoder: ReLU -> conv 1x1 -> sigmoid
+    float logit = net.decoder_bias;
+    for (int j = 0; j < kHidden; j++)
+        logit += net.decoder_weight[j] * (h[j] > 0.0f ? h[j] : 0.0f);
+    return Sigmoid(logit);
+}
+
+}  // namespace vad_native
+
+// NativeVadModel class: the Silero VAD weights for 16 kHz and, if the file has them, 8 kHz.
+// Immutable after loading, so one instance can be shared by any number of iterators and
+// threads.
+class NativeVadModel {
+public:
+    // Loads an ONNX model file. Throws std::runtime_error if the file cannot be read or
+    // does not look like a Silero VAD v5 graph.
+    explicit NativeVadModel(const std::string& onnx_path) {
+        std::ifstream f(onnx_path, std::ios::binary | std::ios::ate);
+        if (!f)
+            throw std::runtime_error("NativeVadModel: cannot open " + onnx_path);
+        std::vector<uint8_t> bytes(static_cast<size_t>(f.tellg()));
+        f.seekg(0);
+        f.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+        load(bytes.data(), bytes.size());
+    }
+
+    // Loads an ONNX model from memory (e.g. embedded_model_data()).
+    NativeVadModel(const void* data, size_t bytes) {
+        load(static_cast<const uint8_t*>(data), bytes);
+    }
+
+    bool supports(int sample_rate) const {
+        return net_for(sample_rate) != NULL;
+    }
+
+    // Network for sample_rate, or NULL if the model has none.
+    const vad_native::Net* net_for(int sample_rate) const {
+        for (const vad_native::Net& net : nets)
+            if (net.sample_rate == sample_rate)
+                return &net;
+        return NULL;
+    }
+
+private:
+    std::vector<vad_native::Net> nets;
+
+    void load(const uint8_t* data, size_t bytes) {
+        std::map<std::string, vad_native::Tensor> tensors;
+        vad_native::ProtoReader model(data, data + bytes);
+        uint32_t field, wire;
+        while (model.next(field, wire)) {
+            if (field == 7 && wire == 2)  // graph
+                vad_native::CollectTensors(model.bytes(), tensors);
+            else
+                model.skip(wire);
+        }
+        // Each If branch of the graph carries a full weight set under its own name prefix.
+        const std::string key = "stft.forward_basis_buffer";
+        for (std::map<std::string, vad_native::Tensor>::const_iterator it = tensors.begin(); it != tensors.end(); ++it) {
+            const std::string& name = it->first;
+            if (name.size() >= key.size() && name.compare(name.size() - key.size(), key.size(), key) == 0)
+                nets.push_back(vad_native::BuildNet(tensors, name.substr(0, name.size() - key.size())));
+        }
+        if (nets.empty())
+            throw std::runtime_error("NativeVadModel: no Silero VAD weights found");
+    }
+};
+
+// NativeVadIterator class: VadIterator's interface on the native engine.
+class NativeVadIterator {
+private:
+    std::shared_ptr<const NativeVadModel> model;
+    const vad_native::Net* net;
+    vad_native::Scratch scratch;
+
+    int sample_rate;
+    int context_samples;
+    int window_size_samples;
+    std::vector<float> input;        // [context_samples | window_size_samples]
+    std::vector<float> _state;       // [h | c]
+    float _output = 0.0f;
+    int64_t audio_length_samples = 0;
+    int pending_samples = 0;
+
+    VadSegmenter segmenter;
+
+    void reset_states() {
+        std::fill(_state.begin(), _state.end(), 0.0f);
+        std::fill(input.begin(), input.end(), 0.0f);
+        _output = 0.0f;
+        audio_length_samples = 0;
+        pending_samples = 0;
+        segmenter.reset();
+    }
+
+    // Runs the window assembled in `input` and shifts the context.
+    void predict() {
+        _output = vad_native::RunNet(*net, input.data(), _state.data(), scratch);
+        std::memmove(input.data(), input.data() + window_size_samples, context_samples * sizeof(float));
+        segmenter.push(_output);
+    }
+
+public:
+    void process(const std::vector<float>& input_wav) {
+        process(input_wav.data(), input_wav.size());
+    }
+
+    void process(const float* input_wav, size_t num_samples) {
+        reset_states();
+        feed(input_wav, num_samples);
+        flush();
+    }
+
+    void feed(const float* samples, size_t num_samples) {
+        feed_from([samples](float* dst, size_t offset, size_t count) {
+            std::memcpy(dst, samples + offset, count * sizeof(float));
+        }, num_samples);
+    }
+
+    // See VadIterator::feed_from().
+    template <typename Reader>
+    void feed_from(Reader&& read, size_t num_samples) {
+        audio_length_samples += static_cast<int64_t>(num_samples);
+        size_t offset = 0;
+        if (pending_samples > 0) {
+            size_t take = std::min(num_samples, static_cast<size_t>(window_size_samples - pending_samples));
+            read(input.data() + context_samples + pending_samples, offset, take);
+            pending_samples += static_cast<int>(take);
+            offset += take;
+            if (pending_samples < window_size_samples)
+                return;
+            pending_samples = 0;
+            predict();
+        }
+        for (; num_samples - offset >= static_cast<size_t>(window_size_samples); offset += window_size_samples) {
+            read(input.data() + context_samples, offset, static_cast<size_t>(window_size_samples));
+            predict();
+        }
+        if (offset < num_samples) {
+            read(input.data() + context_samples, offset, num_samples - offset);
+            pending_samples = static_cast<int>(num_samples - offset);
+        }
+    }
+
+    void flush() {
+        segmenter.flush(audio_length_samples);
+    }
+
+    void set_speech_callbacks(std::function<void(int64_t)> on_start,
+        std::function<void(const timestamp_t&)> on_end) {
+        segmenter.set_speech_callbacks(std::move(on_start), std::move(on_end));
+    }
+
+    float last_speech_prob() const {
+        return _output;
+    }
+
+    const std::vector<timestamp_t> get_speech_timestamps() const {
+        return segmenter.get_speech_timestamps();
+    }
+
+    void reset() {
+        reset_states();
+    }
+
+public:
+    // The window is fixed by the model: 32 ms (512 samples at 16 kHz, 256 at 8 kHz).
+    NativeVadIterator(std::shared_ptr<const NativeVadModel> Model,
+        int Sample_rate = 16000, float Threshold = 0.5, int min_silence_duration_ms = 100,
+        int speech_pad_ms = 30, int min_speech_duration_ms = 250,
+        float max_speech_duration_s = std::numeric_limits<float>::infinity())
+        : model(std::move(Model)), sample_rate(Sample_rate)
+    {
+        net = model->net_for(sample_rate);
+        if (net == NULL)
+            throw std::invalid_argument("NativeVadIterator: the model has no weights for this sample rate");
+        context_samples = net->context;
+        window_size_samples = net->window;
+        input.assign(context_samples + window_size_samples, 0.0f);
+        _state.assign(2 * vad_native::kHidden, 0.0f);
+        segmenter = VadSegmenter(sample_rate, window_size_samples, Threshold, min_silence_duration_ms,
+            speech_pad_ms, min_speech_duration_ms, max_speech_duration_s);
+    }
+};
+
+#endif  // SILERO_VAD_NATIVE_H_
@@ -0,0 +1,725 @@
+#ifndef SILERO_VAD_ONNX_H_
+#define SILERO_VAD_ONNX_H_
+
+#include <vector>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <cstdio>
+#include <functional>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <random>
+#include <cstdint>
+#include <sys/stat.h>
+
+#include "onnxruntime_cxx_api.h"
+#include "silero-vad-resampler.h"
+#include "silero-vad-segmenter.h"
+#include "silero-vad-stats.h"
+
+// Converts a wide-character model path to the form ONNX Runtime takes: wchar_t on Windows,
+// UTF-8 char elsewhere.
+inline std::basic_string<ORTCHAR_T> ort_path(const std::wstring& path) {
+#ifdef _WIN32
+    return path;
+#else
+    std::string out;
+    for (wchar_t wc : path) {
+        unsigned long c = static_cast<unsigned long>(wc);
+        if (c < 0x80) {
+            out += static_cast<char>(c);
+        } else if (c < 0x800) {
+            out += static_cast<char>(0xC0 | (c >> 6));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            out += static_cast<char>(0xE0 | (c >> 12));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (c >> 18));
+            out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return out;
+#endif
+}
+
+// Samples of the previous window that the model takes as context in front of each window:
+// 64 at 16 kHz, 32 at 8 kHz.
+inline int vad_context_samples(int sample_rate) {
+    return sample_rate == 8000 ? 32 : 64;
+}
+
+// Precision of the model weights. All variants take and return float32 tensors.
+//   FP32: silero_vad.onnx (reference; 8 and 16 kHz)
+//   FP16: silero_vad_half.onnx, fp16 weights cast to fp32 inside the graph. It has no `sr`
+//         input and is 16 kHz only. Without native fp16 kernels, ONNX Runtime computes
+//         around the casts in fp32.
+//   INT8: silero_vad_int8.onnx, dynamically quantized from silero_vad_16k_op15.onnx by
+//         quantize_int8.py (16 kHz).
+enum VadPrecision {
+    VAD_PRECISION_FP32 = 0,
+    VAD_PRECISION_FP16,
+    VAD_PRECISION_INT8
+};
+
+inline const char* vad_precision_name(VadPrecision precision) {
+    switch (precision) {
+    case VAD_PRECISION_FP16: return "fp16";
+    case VAD_PRECISION_INT8: return "int8";
+    default: return "fp32";
+    }
+}
+
+// Path of the model file for `precision` in model_dir (e.g. "../../src/silero_vad/data").
+inline std::basic_string<ORTCHAR_T> vad_model_path(const std::string& model_dir, VadPrecision precision) {
+    const char* file = precision == VAD_PRECISION_FP16 ? "silero_vad_half.onnx"
+        : precision == VAD_PRECISION_INT8 ? "silero_vad_int8.onnx" : "silero_vad.onnx";
+    std::string path = model_dir.empty() ? file : model_dir + "/" + file;
+    return std::basic_string<ORTCHAR_T>(path.begin(), path.end());
+}
+
+// VadModelOptions: session settings. Together with the model source they identify a
+// loaded model in the VadModel registry.
+struct VadModelOptions {
+    int intra_threads;
+    int inter_threads;
+    // Optimized-graph cache. The file actually used is this path with the ONNX Runtime
+    // version and the source model's identity (size and mtime of a file, size and hash of a
+    // buffer) inserted before the extension, see VadModel::optimized_cache_path(). If it
+    // exists, it is loaded with graph optimization disabled, so start-up skips
+    // ORT_ENABLE_ALL. Otherwise the model is optimized as usual and the result is written to
+    // a temporary file and renamed into place, so processes sharing the directory never
+    // load a partly written cache. A ".ort" extension selects ONNX Runtime's ORT format,
+    // which loads fastest. The cache is also tied to the CPU: do not share it between
+    // machines of different types.
+    std::basic_string<ORTCHAR_T> optimized_model_path;
+
+    VadModelOptions(int intra = 1, int inter = 1)
+        : intra_threads(intra), inter_threads(inter) { }
+
+    // Registry key for these options.
+    std::string key() const {
+        std::string k = "intra=" + std::to_string(intra_threads) + ";inter=" + std::to_string(inter_threads);
+        if (!optimized_model_path.empty())
+            k += ";cache=" + std::string(optimized_model_path.begin(), optimized_model_path.end());
+        return k;
+    }
+};
+
+// VadModel class: one loaded ONNX Runtime session. Ort::Session::Run is thread-safe, so a
+// single VadModel can be shared (via std::shared_ptr) by many iterators, engines and worker
+// threads. VadModel::get() returns the process-wide instance for a path and options, so the
+// model is parsed, optimized and held in memory once however many streams use it.
+class VadModel {
+public:
+    std::shared_ptr<Ort::Env> env;   // Process-wide; kept alive by every model using it.
+    Ort::SessionOptions session_options;
+    std::shared_ptr<Ort::Session> session = nullptr;
+    size_t num_inputs = 3;           // input, state[, sr]: 16 kHz-only exports have no sr input
+
+    VadModel(const std::basic_string<ORTCHAR_T>& model_path, int intra_threads = 1, int inter_threads = 1)
+        : VadModel(model_path, VadModelOptions(intra_threads, inter_threads)) { }
+
+    // Loads the model from a file.
+    VadModel(const std::basic_string<ORTCHAR_T>& model_path, const VadModelOptions& options)
+        : env(shared_env())
+    {
+        create_session(options, file_stamp(model_path), [&]() {
+            return std::make_shared<Ort::Session>(*env, model_path.c_str(), session_options);
+        });
+        num_inputs = session->GetInputCount();
+    }
+
+    // Loads the model from a memory buffer (e.g. the bytes embedded by silero-vad-embedded.h).
+    // The buffer is only read during construction.
+    VadModel(const void* model_data, size_t model_bytes, const VadModelOptions& options = VadModelOptions())
+        : env(shared_env())
+    {
+        create_session(options, options.optimized_model_path.empty() ? std::string() : buffer_stamp(model_data, model_bytes),
+            [&]() { return std::make_shared<Ort::Session>(*env, model_data, model_bytes, session_options); });
+        num_inputs = session->GetInputCount();
+    }
+
+    // The optimized-graph cache file used for the model at model_path, e.g.
+    // "cache/silero_vad.ort" -> "cache/silero_vad.ort1.17.0-2327524-1718000000.ort".
+    // Empty if options has no cache or the model file cannot be read.
+    static std::basic_string<ORTCHAR_T> optimized_cache_path(const std::basic_string<ORTCHAR_T>& model_path,
+        const VadModelOptions& options) {
+        const std::string stamp = file_stamp(model_path);
+        if (options.optimized_model_path.empty() || stamp.empty())
+            return std::basic_string<ORTCHAR_T>();
+        return insert_before_extension(options.optimized_model_path, cache_tag(stamp));
+    }
+
+    // Throws if the model cannot run at sample_rate: 8000 or 16000 Hz, and 16000 only for
+    // models without an sr input. Audio at other rates must be resampled first (see
+    // VadIterator::set_input_sample_rate()).
+    void check_sample_rate(int sample_rate) const {
+        if (sample_rate != 16000 && sample_rate != 8000)
+            throw std::invalid_argument("VadModel: the model runs at 8000 or 16000 Hz");
+        if (num_inputs < 3 && sample_rate != 16000)
+            throw std::invalid_argument("VadModel: this model supports 16000 Hz only");
+    }
+
+    // Returns the shared model for (model_path, options), loading it on first use.
+    // The registry holds only weak references: the model is released when the last
+    // iterator or engine using it goes away, and loaded again by the next get().
+    static std::shared_ptr<VadModel> get(const std::basic_string<ORTCHAR_T>& model_path,
+        const VadModelOptions& options = VadModelOptions()) {
+        return get_or_load(Key(model_path, options.key()), [&]() {
+            return std::make_shared<VadModel>(model_path, options);
+        });
+    }
+
+    // Same as get() for a model held in memory. `name` identifies the buffer in the registry.
+    static std::shared_ptr<VadModel> get(const std::string& name, const void* model_data, size_t model_bytes,
+        const VadModelOptions& options = VadModelOptions()) {
+        return get_or_load(Key(std::basic_string<ORTCHAR_T>(), "memory=" + name + ";" + options.key()), [&]() {
+            return std::make_shared<VadModel>(model_data, model_bytes, options);
+        });
+    }
+
+private:
+    typedef std::pair<std::basic_string<ORTCHAR_T>, std::string> Key;
+
+    static std::shared_ptr<VadModel> get_or_load(const Key& key,
+        const std::function<std::shared_ptr<VadModel>()>& load) {
+        static std::mutex mutex;
+        static std::map<Key, std::weak_ptr<VadModel>> registry;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = registry.begin(); it != registry.end();) {
+            if (it->second.expired())
+                it = registry.erase(it);
+            else
+                ++it;
+        }
+        std::weak_ptr<VadModel>& slot = registry[key];
+        std::shared_ptr<VadModel> model = slot.lock();
+        if (!model) {
+            model = load();
+            slot = model;
+        }
+        return model;
+    }
+
+    // Sets threading and optimization and creates the session: from the optimized-graph
+    // cache if there is one for source_stamp, otherwise with load_source(), saving the cache.
+    void create_session(const VadModelOptions& options, const std::string& source_stamp,
+        const std::function<std::shared_ptr<Ort::Session>()>& load_source) {
+        session_options.SetIntraOpNumThreads(options.intra_threads);
+        session_options.SetInterOpNumThreads(options.inter_threads);
+        if (options.optimized_model_path.empty() || source_stamp.empty()) {
+            session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+            session = load_source();
+            return;
+        }
+        const std::basic_string<ORTCHAR_T> cache = insert_before_extension(options.optimized_model_path,
+            cache_tag(source_stamp));
+        if (file_exists(cache)) {
+            session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_DISABLE_ALL);
+            session = std::make_shared<Ort::Session>(*env, cache.c_str(), session_options);
+            return;
+        }
+        // ONNX Runtime writes the optimized graph while creating the session. A unique name
+        // (same extension, so the format is kept) keeps concurrent writers apart; rename()
+        // then publishes a complete file. If another process got there first, its cache is
+        // equivalent and ours is dropped.
+        std::random_device rd;
+        const std::basic_string<ORTCHAR_T> tmp = insert_before_extension(cache,
+            "tmp" + std::to_string((static_cast<uint64_t>(rd()) << 32) | static_cast<uint64_t>(rd())));
+        session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+        session_options.SetOptimizedModelFilePath(tmp.c_str());
+        try {
+            session = load_source();
+        } catch (...) {
+            remove_file(tmp);
+            throw;
+        }
+        if (!rename_file(tmp, cache))
+            remove_file(tmp);
+    }
+
+    // "ort<version>-<source_stamp>": the part of the cache name that must match.
+    static std::string cache_tag(const std::string& source_stamp) {
+        return std::string("ort") + OrtGetApiBase()->GetVersionString() + "-" + source_stamp;
+    }
+
+    // "dir/name.ext" -> "dir/name.<tag>.ext" ("dir/name" -> "dir/name.<tag>").
+    static std::basic_string<ORTCHAR_T> insert_before_extension(const std::basic_string<ORTCHAR_T>& path,
+        const std::string& tag) {
+        size_t dot = path.size();
+        for (size_t i = path.size(); i-- > 0 && path[i] != '/' && path[i] != '\\'; ) {
+            if (path[i] == '.') {
+                dot = i;
+                break;
+            }
+        }
+        std::basic_string<ORTCHAR_T> out = path.substr(0, dot);
+        out += ORTCHAR_T('.');
+        out.append(tag.begin(), tag.end());
+        out += path.substr(dot);
+        return out;
+    }
+
+    // Size and modification time of a model file, or "" if it cannot be read.
+    static std::string file_stamp(const std::basic_string<ORTCHAR_T>& path) {
+#ifdef _WIN32
+        struct _stat64 st;
+        if (_wstat64(path.c_str(), &st) != 0)
+            return std::string();
+#else
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0)
+            return std::string();
+#endif
+        return std::to_string(static_cast<long long>(st.st_size)) + "-" + std::to_string(static_cast<long long>(st.st_mtime));
+    }
+
+    // Size and 64-bit FNV-1a hash of a model held in memory.
+    static std::string buffer_stamp(const void* data, size_t bytes) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < bytes; i++)
+            hash = (hash ^ p[i]) * 1099511628211ull;
+        char hex[17];
+        snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+        return std::to_string(bytes) + "-" + hex;
+    }
+
+    static bool file_exists(const std::basic_string<ORTCHAR_T>& path) {
+#ifdef _WIN32
+        FILE* f = _wfopen(path.c_str(), L"rb");
+#else
+        FILE* f = fopen(path.c_str(), "rb");
+#endif
+        if (f == NULL)
+            return false;
+        fclose(f);
+        return true;
+    }
+
+    // Replaces `to` if the platform allows (POSIX rename is atomic); false if it failed.
+    static bool rename_file(const std::basic_string<ORTCHAR_T>& from, const std::basic_string<ORTCHAR_T>& to) {
+#ifdef _WIN32
+        return _wrename(from.c_str(), to.c_str()) == 0;
+#else
+        return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+    static void remove_file(const std::basic_string<ORTCHAR_T>& path) {
+#ifdef _WIN32
+        _wremove(path.c_str());
+#else
+        std::remove(path.c_str());
+#endif
+    }
+
+    // One Ort::Env per process, as ONNX Runtime recommends.
+    static std::shared_ptr<Ort::Env> shared_env() {
+        static std::shared_ptr<Ort::Env> env = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "silero-vad");
+        return env;
+    }
+};
+
+// VadOrtIo class: the model's input/output buffers for up to max_batch windows and the
+// Ort::Value tensors over them:
+//   "input" {N, context + window}, "state"/"stateN" {2, N, 128}, "sr" {1}, "output" {N, 1}
+// VadIterator, OnnxVadEngine and BatchedVadEngine all run the model through it, so the
+// tensor layout is defined only here. Tensors for a batch size are created on its first
+// run; with max_batch 1 they are created up front, so no run allocates.
+class VadOrtIo {
+public:
+    static const int kStateSize = 128;  // Floats per LSTM layer and stream
+
+private:
+    Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeCPU);
+    int context_size;
+    int window_size;
+    int row_size;                    // context_size + window_size
+    size_t max_batch;
+
+    std::vector<const char*> input_node_names = { "input", "state", "sr" };
+    std::vector<const char*> output_node_names = { "output", "stateN" };
+    std::vector<float> _input;       // {max_batch, row_size}, rows [context | window]
+    std::vector<float> _state;       // {2, N, 128} for a run with N rows
+    std::vector<float> _stateN;      // Next state, same layout as _state
+    std::vector<float> _output;      // {N, 1}
+    std::vector<int64_t> sr;
+
+    struct Tensors {
+        std::vector<Ort::Value> inputs;
+        std::vector<Ort::Value> outputs;
+    };
+    std::vector<std::unique_ptr<Tensors>> tensors;  // Indexed by batch size
+
+    Tensors& tensors_for(size_t n) {
+        std::unique_ptr<Tensors>& t = tensors[n];
+        if (!t) {
+            const int64_t batch = static_cast<int64_t>(n);
+            const int64_t input_dims[2] = { batch, row_size };
+            const int64_t state_dims[3] = { 2, batch, kStateSize };
+            const int64_t sr_dims[1] = { 1 };
+            const int64_t output_dims[2] = { batch, 1 };
+            t.reset(new Tensors());
+            t->inputs.emplace_back(Ort::Value::CreateTensor<float>(
+                memory_info, _input.data(), n * row_size, input_dims, 2));
+            t->inputs.emplace_back(Ort::Value::CreateTensor<float>(
+                memory_info, _state.data(), 2 * n * kStateSize, state_dims, 3));
+            t->inputs.emplace_back(Ort::Value::CreateTensor<int64_t>(
+                memory_info, sr.data(), sr.size(), sr_dims, 1));
+            t->outputs.emplace_back(Ort::Value::CreateTensor<float>(
+                memory_info, _output.data(), n, output_dims, 2));
+            t->outputs.emplace_back(Ort::Value::CreateTensor<float>(
+                memory_info, _stateN.data(), 2 * n * kStateSize, state_dims, 3));
+        }
+        return *t;
+    }
+
+public:
+    VadOrtIo(const VadModel& model, int sample_rate, int Window_samples, size_t Max_batch = 1)
+        : max_batch(Max_batch)
+    {
+        model.check_sample_rate(sample_rate);
+        context_size = vad_context_samples(sample_rate);
+        window_size = Window_samples;
+        row_size = context_size + window_size;
+        _input.assign(max_batch * row_size, 0.0f);
+        _state.assign(2 * max_batch * kStateSize, 0.0f);
+        _stateN.assign(_state.size(), 0.0f);
+        _output.assign(max_batch, 0.0f);
+        sr.assign(1, sample_rate);
+        tensors.resize(max_batch + 1);
+        if (max_batch == 1)
+            tensors_for(1);
+    }
+
+    int context_samples() const {
+        return context_size;
+    }
+
+    int window_samples() const {
+        return window_size;
+    }
+
+    // Row b of the input: context_samples() followed by window_samples().
+    float* input(size_t b = 0) {
+        return _input.data() + b * row_size;
+    }
+
+    // LSTM layer k (0 or 1) of row b in a run with n rows: kStateSize floats.
+    float* state(size_t k, size_t b = 0, size_t n = 1) {
+        return _state.data() + (k * n + b) * kStateSize;
+    }
+
+    const float* next_state(size_t k, size_t b = 0, size_t n = 1) const {
+        return _stateN.data() + (k * n + b) * kStateSize;
+    }
+
+    // Speech probability of row b from the last run.
+    float output(size_t b = 0) const {
+        return _output[b];
+    }
+
+    // Runs the first n rows (at most max_batch) through the model.
+    void run(const VadModel& model, size_t n = 1) {
+        Tensors& t = tensors_for(n);
+        model.session->Run(
+            Ort::RunOptions{ nullptr },
+            input_node_names.data(), t.inputs.data(), model.num_inputs,
+            output_node_names.data(), t.outputs.data(), t.outputs.size());
+    }
+
+    // Single stream, after run(): the next state becomes the state, and the last
+    // context_samples() of the input move to its head as the next window's context.
+    void advance() {
+        std::memcpy(_state.data(), _stateN.data(), 2 * kStateSize * sizeof(float));
+        std::memmove(_input.data(), _input.data() + window_size, context_size * sizeof(float));
+    }
+
+    // Single stream: zeroes the context and the state.
+    void reset() {
+        std::fill(_input.begin(), _input.begin() + row_size, 0.0f);
+        std::fill(_state.begin(), _state.begin() + 2 * kStateSize, 0.0f);
+    }
+};
+
+// VadIterator class: uses ONNX Runtime to detect speech segments.
+class VadIterator {
+private:
+    // ONNX Runtime resources. The model (session and weights) is shared; everything
+    // below it is per-stream state.
+    std::shared_ptr<VadModel> model;
+
+    // ----- Context-related additions -----
+    int context_samples;  // 64 samples at 16 kHz, 32 at 8 kHz (see vad_context_samples()).
+    // The context (last samples of the previous chunk) lives at the head of io.input(),
+    // so no separate buffer is needed; reset_states() zeroes it.
+
+    // Original window size (e.g., 32ms corresponds to 512 samples)
+    int window_size_samples;
+    // Effective window size = window_size_samples + context_samples
+    int effective_window_size;
+
+    // Additional declaration: samples per millisecond
+    int sr_per_ms;
+
+    // ONNX Runtime input/output buffers and the tensors over them, created once in the
+    // constructor, so steady-state predict() does no heap allocation.
+    VadOrtIo io;
+
+    // Model configuration parameters
+    int sample_rate;
+    int64_t audio_length_samples = 0;
+
+    // Segment state machine
+    VadSegmenter segmenter;
+
+    // Streaming (feed) support
+    int pending_samples = 0;  // Samples of the next window already copied into `input` by feed().
+
+    // Optional resampling of fed audio to sample_rate (see set_input_sample_rate()).
+    std::unique_ptr<StreamingResampler> resampler;
+    std::vector<float> resampled;
+
+#ifdef SILERO_VAD_STATS
+    // Per-stage timings (see silero-vad-stats.h)
+    VadStats _stats;
+    uint64_t input_ns = 0;    // Input time of the window being assembled.
+#endif
+
+    // Resets internal state (model state, context, etc.)
+    void reset_states() {
+        io.reset();
+        segmenter.reset();
+        audio_length_samples = 0;
+        pending_samples = 0;
+        if (resampler)
+            resampler->reset();
+    }
+
+    // Runs resampled audio through the model.
+    void feed_resampled() {
+        const float* samples = resampled.data();
+        feed_from([samples](float* dst, size_t offset, size_t count) {
+            std::memcpy(dst, samples + offset, count * sizeof(float));
+        }, resampled.size());
+        resampled.clear();
+    }
+
+    // Inference: runs inference on one chunk of input data.
+    // data_chunk must point to window_size_samples samples. Passing nullptr means the
+    // window has already been assembled in place after the context (see feed()).
+    void predict(const float* data_chunk) {
+        SILERO_VAD_STATS_DO(uint64_t t0 = vad_stats_now_ns());
+        // The head of the input already holds the context; append the current chunk after it.
+        if (data_chunk)
+            std::memcpy(io.input() + context_samples, data_chunk, window_size_samples * sizeof(float));
+        SILERO_VAD_STATS_DO(uint64_t t1 = vad_stats_now_ns(); input_ns += t1 - t0);
+
+        // Run inference into the pre-created output tensors.
+        io.run(*model);
+        SILERO_VAD_STATS_DO(uint64_t t2 = vad_stats_now_ns());
+
+        float speech_prob = io.output();
+        // Take the next state, and move the end of this input to the head as the next context.
+        io.advance();
+        SILERO_VAD_STATS_DO(uint64_t t3 = vad_stats_now_ns());
+        segmenter.push(speech_prob);
+        SILERO_VAD_STATS_DO(record_window(t1, t2, t3, vad_stats_now_ns()));
+    }
+
+#ifdef SILERO_VAD_STATS
+    void record_window(uint64_t run_begin, uint64_t state_begin, uint64_t segmenter_begin, uint64_t end) {
+        _stats.stage[VAD_STAGE_INPUT].record(input_ns);
+        _stats.stage[VAD_STAGE_RUN].record(state_begin - run_begin);
+        _stats.stage[VAD_STAGE_STATE].record(segmenter_begin - state_begin);
+        _stats.stage[VAD_STAGE_SEGMENTER].record(end - segmenter_begin);
+        _stats.stage[VAD_STAGE_WINDOW].record(input_ns + (end - run_begin));
+        input_ns = 0;
+    }
+#endif
+
+public:
+    // Process the entire audio input.
+    void process(const std::vector<float>& input_wav) {
+        process(input_wav.data(), input_wav.size());
+    }
+
+    // Process the entire audio input from a raw buffer of num_samples samples.
+    // Windows are fed to the model in place; no per-window buffers are allocated.
+    void process(const float* input_wav, size_t num_samples) {
+        reset_states();
+        feed(input_wav, num_samples);
+        flush();
+    }
+
+    // Streaming input: accepts any number of samples and keeps the context, model state and
+    // segment state between calls. Whole windows are run as soon as they are complete, so
+    // speech start/end callbacks fire within one window of the decision. A trailing partial
+    // window is kept (in place, after the context) until the next call.
+    // With set_input_sample_rate(), samples are at the input rate and are resampled first.
+    void feed(const float* samples, size_t num_samples) {
+        if (resampler) {
+            resampler->process(samples, num_samples, resampled);
+            feed_resampled();
+            return;
+        }
+        feed_from([samples](float* dst, size_t offset, size_t count) {
+            std::memcpy(dst, samples + offset, count * sizeof(float));
+        }, num_samples);
+    }
+
+    // Same as feed(), but the samples are produced by read(dst, offset, count), which must write
+    // samples [offset, offset + count) of the num_samples being fed to dst as float. dst points
+    // straight into the model input buffer, so e.g. PCM from a memory-mapped file is converted
+    // in place, window by window, without an intermediate float copy of the audio.
+    // The samples must be at sample_rate; set_input_sample_rate() does not apply here.
+    template <typename Reader>
+    void feed_from(Reader&& read, size_t num_samples) {
+        audio_length_samples += static_cast<int64_t>(num_samples);
+        size_t offset = 0;
+        if (pending_samples > 0) {
+            size_t take = std::min(num_samples, static_cast<size_t>(window_size_samples - pending_samples));
+            SILERO_VAD_STATS_DO(uint64_t t = vad_stats_now_ns());
+            read(io.input() + context_samples + pending_samples, offset, take);
+            SILERO_VAD_STATS_DO(input_ns += vad_stats_now_ns() - t);
+            pending_samples += static_cast<int>(take);
+            offset += take;
+            if (pending_samples < window_size_samples)
+                return;
+            pending_samples = 0;
+            predict(nullptr);
+        }
+        // Process audio in chunks of window_size_samples (e.g., 512 samples)
+        for (; num_samples - offset >= static_cast<size_t>(window_size_samples); offset += window_size_samples) {
+            SILERO_VAD_STATS_DO(uint64_t t = vad_stats_now_ns());
+            read(io.input() + context_samples, offset, static_cast<size_t>(window_size_samples));
+            SILERO_VAD_STATS_DO(input_ns += vad_stats_now_ns() - t);
+            predict(nullptr);
+        }
+        if (offset < num_samples) {
+            SILERO_VAD_STATS_DO(uint64_t t = vad_stats_now_ns());
+            read(io.input() + context_samples, offset, num_samples - offset);
+            SILERO_VAD_STATS_DO(input_ns += vad_stats_now_ns() - t);
+            pending_samples = static_cast<int>(num_samples - offset);
+        }
+    }
+
+    // Runs one window given together with its context: effective_window_samples() samples,
+    // [context | window], e.g. a view from VadRingBuffer::peek_window(). The samples must
+    // be at sample_rate. Use either this or feed() on a stream, not both.
+    void feed_window(const float* context_and_window) {
+        audio_length_samples += window_size_samples;
+        SILERO_VAD_STATS_DO(uint64_t t = vad_stats_now_ns());
+        std::memcpy(io.input(), context_and_window, effective_window_size * sizeof(float));
+        SILERO_VAD_STATS_DO(input_ns += vad_stats_now_ns() - t);
+        predict(nullptr);
+    }
+
+    int window_samples() const {
+        return window_size_samples;
+    }
+
+    int effective_window_samples() const {
+        return effective_window_size;
+    }
+
+    // Ends the stream: closes an open speech segment at the end of the fed audio.
+    // A trailing partial window is dropped, as in process(). Call reset() before reusing.
+    void flush() {
+        if (resampler) {
+            resampler->flush(resampled);
+            feed_resampled();
+        }
+        segmenter.flush(audio_length_samples);
+    }
+
+    // Registers listeners for live segment events (either may be empty).
+    // on_start receives the start sample; on_end receives the finished segment.
+    void set_speech_callbacks(std::function<void(int64_t)> on_start,
+        std::function<void(const timestamp_t&)> on_end) {
+        segmenter.set_speech_callbacks(std::move(on_start), std::move(on_end));
+    }
+
+    // Accepts feed()/process() audio at input_rate (e.g. 44100 or 48000 Hz) and resamples
+    // it to sample_rate on the fly, keeping the filter state across calls. Timestamps stay
+    // in samples at sample_rate. Passing sample_rate turns resampling off. Call it before
+    // feeding a stream.
+    void set_input_sample_rate(int input_rate) {
+        if (input_rate == sample_rate) {
+            resampler.reset();
+            return;
+        }
+        resampler.reset(new StreamingResampler(input_rate, sample_rate));
+        resampled.reserve(resampler->max_output(static_cast<size_t>(input_rate)));
+    }
+
+    // Speech probability of the most recently processed window.
+    float last_speech_prob() const {
+        return io.output();
+    }
+
+    // Returns the detected speech timestamps.
+    const std::vector<timestamp_t> get_speech_timestamps() const {
+        return segmenter.get_speech_timestamps();
+    }
+
+    // Public method to reset the internal state.
+    void reset() {
+        reset_states();
+    }
+
+#ifdef SILERO_VAD_STATS
+    // Per-stage latency histograms since construction or the last reset_stats().
+    // Only available when built with -DSILERO_VAD_STATS.
+    const VadStats& stats() const {
+        return _stats;
+    }
+
+    void reset_stats() {
+        _stats.reset();
+    }
+#endif
+
+public:
+    // Constructor: sets model path, sample rate, window size (ms), and other parameters.
+    // The parameters are set to match the Python version. The model comes from the
+    // VadModel registry, so only the first iterator for a path loads it.
+    VadIterator(const std::wstring ModelPath,
+        int Sample_rate = 16000, int windows_frame_size = 32,
+        float Threshold = 0.5, int min_silence_duration_ms = 100,
+        int speech_pad_ms = 30, int min_speech_duration_ms = 250,
+        float max_speech_duration_s = std::numeric_limits<float>::infinity())
+        : VadIterator(VadModel::get(ort_path(ModelPath)), Sample_rate, windows_frame_size, Threshold,
+            min_silence_duration_ms, speech_pad_ms, min_speech_duration_ms, max_speech_duration_s) { }
+
+    // Constructor on an already loaded (shared) model. This only sets up the per-stream
+    // buffers and tensors, so creating a stream takes microseconds.
+    VadIterator(std::shared_ptr<VadModel> Model,
+        int Sample_rate = 16000, int windows_frame_size = 32,
+        float Threshold = 0.5, int min_silence_duration_ms = 100,
+        int speech_pad_ms = 30, int min_speech_duration_ms = 250,
+        float max_speech_duration_s = std::numeric_limits<float>::infinity())
+        : model(std::move(Model)),
+          io(*model, Sample_rate, windows_frame_size * (Sample_rate / 1000)),
+          sample_rate(Sample_rate)
+    {
+        context_samples = vad_context_samples(sample_rate);
+        sr_per_ms = sample_rate / 1000;  // e.g., 16000 / 1000 = 16
+        window_size_samples = windows_frame_size * sr_per_ms; // e.g., 32ms * 16 = 512 samples
+        effective_window_size = window_size_samples + context_samples; // e.g., 512 + 64 = 576 samples (256 + 32 at 8 kHz)
+        segmenter = VadSegmenter(sample_rate, window_size_samples, Threshold, min_silence_duration_ms,
+            speech_pad_ms, min_speech_duration_ms, max_speech_duration_s);
+    }
+};
+
+#endif  // SILERO_VAD_ONNX_H_
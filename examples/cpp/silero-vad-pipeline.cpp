@@ -0,0 +1,192 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Offline throughput: the three-stage VadPipeline against the one-file-at-a-time loop.
+//
+// It writes --files synthetic 16-bit WAV files of --seconds each (16 kHz mono, 48 kHz mono
+// and 16 kHz stereo in turn) and processes them three ways:
+//   sequential   : WavReader decodes the whole file, the samples are copied to a vector,
+//                  the VAD runs, the result is printed, then the next file
+//   pipeline_1   : VadPipeline with one inference worker (decoding overlaps inference)
+//   pipeline_N   : VadPipeline with --infer-threads workers
+// For the pipeline runs it reports per stage the busy time and utilization, and per queue
+// the mean/max depth and the time producers (full) and consumers (empty) were stalled.
+// A stage whose consumers stall on an empty input queue is the one to give more threads;
+// a queue whose producers stall is too small or feeds the bottleneck.
+// results_match checks every run against the sequential one. Output is JSON.
+//
+// Usage: ./pipeline [--model silero_vad.onnx] [--files 24] [--seconds 60] [--dir .]
+//                   [--decode-threads 1] [--infer-threads N] [--queue 4] [--prefetch 1048576]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "silero-vad-pipeline.h"
+#include "silero-vad-testaudio.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double seconds_since(Clock::time_point t) {
+    return std::chrono::duration<double>(Clock::now() - t).count();
+}
+
+// Writes file i: 16 kHz mono, 48 kHz mono or 16 kHz stereo (second channel delayed).
+std::string write_test_file(const std::string& dir, size_t i, double seconds) {
+    const int kinds[3][2] = { { 16000, 1 }, { 48000, 1 }, { 16000, 2 } };
+    const int rate = kinds[i % 3][0], channels = kinds[i % 3][1];
+    std::vector<float> audio = make_test_audio(rate, seconds, static_cast<unsigned>(100 + i));
+    std::vector<float> pcm(audio.size() * channels);
+    for (size_t k = 0; k < audio.size(); k++) {
+        for (int c = 0; c < channels; c++) {
+            float v = audio[(k + audio.size() - c * rate / 2) % audio.size()];
+            pcm[k * channels + c] = std::max(-1.0f, std::min(1.0f, v)) * 32767.0f;
+        }
+    }
+    std::string path = dir + "/silero_vad_pipeline_" + std::to_string(i) + ".wav";
+    wav::WavWriter writer(pcm.data(), static_cast<int>(audio.size()), channels, rate, 16);
+    writer.Write(path);
+    return path;
+}
+
+// What main() does for one file, one file after another.
+std::vector<std::vector<timestamp_t>> process_sequential(std::shared_ptr<VadModel> model, const std::string& path,
+    FILE* out) {
+    std::cout.setstate(std::ios::failbit);   // WavReader::Open logs the header to std::cout
+    wav::WavReader reader(path);
+    std::cout.clear();
+    const int channels = reader.num_channel();
+    const size_t frames = reader.num_samples();
+    std::vector<float> samples(reader.data(), reader.data() + frames * channels);
+    std::vector<std::vector<timestamp_t>> speech(channels);
+    if (channels > 1 && reader.sample_rate() == 16000) {
+        MultiChannelVad vad(model, channels);
+        vad.feed_interleaved(samples.data(), frames);
+        vad.flush();
+        for (int c = 0; c < channels; c++)
+            speech[c] = vad.get_speech_timestamps(c);
+    } else {
+        VadIterator vad(model);
+        vad.set_input_sample_rate(reader.sample_rate());
+        std::vector<float> plane(frames);
+        for (int c = 0; c < channels; c++) {
+            for (size_t k = 0; k < frames; k++)
+                plane[k] = samples[k * channels + c];
+            vad.process(plane);
+            speech[c] = vad.get_speech_timestamps();
+        }
+    }
+    for (int c = 0; c < channels; c++)
+        fprintf(out, "%s %d %zu\n", path.c_str(), c, speech[c].size());
+    return speech;
+}
+
+void print_stage(const char* name, const VadStageStats& s, double wall_s, bool last) {
+    printf("      \"%s\": {\"threads\": %zu, \"items\": %zu, \"busy_s\": %.3f, \"utilization\": %.3f}%s\n",
+        name, s.threads, s.items, s.busy_s, s.threads ? s.busy_s / (wall_s * s.threads) : 0.0, last ? "" : ",");
+}
+
+void print_queue(const char* name, const VadQueueStats& q, bool last) {
+    printf("      \"%s\": {\"capacity\": %zu, \"mean_depth\": %.2f, \"max_depth\": %zu, "
+        "\"producer_stall_s\": %.3f, \"consumer_stall_s\": %.3f}%s\n",
+        name, q.capacity, q.mean_depth(), q.max_depth, q.push_wait_s, q.pop_wait_s, last ? "" : ",");
+}
+
+void print_pipeline(const char* name, const VadPipelineStats& s, bool match, bool last) {
+    printf("  \"%s\": {\n    \"wall_s\": %.3f, \"files_per_sec\": %.2f, \"audio_x_realtime\": %.1f, "
+        "\"failures\": %zu, \"results_match\": %s,\n    \"stages\": {\n",
+        name, s.wall_s, s.files / s.wall_s, s.audio_seconds / s.wall_s, s.failures, match ? "true" : "false");
+    print_stage("decode", s.decode, s.wall_s, false);
+    print_stage("infer", s.infer, s.wall_s, false);
+    print_stage("emit", s.emit, s.wall_s, true);
+    printf("    },\n    \"queues\": {\n");
+    print_queue("decoded", s.decoded_queue, false);
+    print_queue("results", s.result_queue, true);
+    printf("    }\n  }%s\n", last ? "" : ",");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = "../../src/silero_vad/data/silero_vad.onnx";
+    std::string dir = ".";
+    size_t num_files = 24;
+    double seconds = 60.0;
+    VadPipelineOptions options;
+    options.infer_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--model") model_arg = argv[i + 1];
+        else if (key == "--files") num_files = std::stoul(argv[i + 1]);
+        else if (key == "--seconds") seconds = std::stod(argv[i + 1]);
+        else if (key == "--dir") dir = argv[i + 1];
+        else if (key == "--decode-threads") options.decode_threads = std::stoul(argv[i + 1]);
+        else if (key == "--infer-threads") options.infer_threads = std::stoul(argv[i + 1]);
+        else if (key == "--queue") options.decoded_queue = std::stoul(argv[i + 1]);
+        else if (key == "--prefetch") options.prefetch_samples = std::stoul(argv[i + 1]);
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < num_files; i++)
+        paths.push_back(write_test_file(dir, i, seconds));
+    std::shared_ptr<VadModel> model = VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end()));
+
+    // The per-file results go to a null sink in every run, so only the processing is timed.
+    FILE* sink = fopen(
+#ifdef _WIN32
+        "NUL",
+#else
+        "/dev/null",
+#endif
+        "w");
+    std::vector<std::vector<std::vector<timestamp_t>>> expected;
+    Clock::time_point t = Clock::now();
+    for (const std::string& path : paths)
+        expected.push_back(process_sequential(model, path, sink));
+    const double sequential_s = seconds_since(t);
+
+    struct Run {
+        std::string name;
+        VadPipelineStats stats;
+        bool match = true;
+    };
+    std::vector<Run> runs;
+    const size_t thread_counts[2] = { 1, options.infer_threads };
+    for (size_t k = 0; k < 2; k++) {
+        if (k == 1 && thread_counts[1] == 1)
+            break;
+        VadPipelineOptions o = options;
+        o.infer_threads = thread_counts[k];
+        Run run;
+        run.name = "pipeline_" + std::to_string(o.infer_threads);
+        VadPipeline pipeline(model, o);
+        run.stats = pipeline.run(paths, [&](const VadFileResult& r) {
+            run.match = run.match && r.ok() && r.speech == expected[r.index];
+            for (size_t c = 0; c < r.speech.size(); c++)
+                fprintf(sink, "%s %zu %zu\n", r.path.c_str(), c, r.speech[c].size());
+        });
+        runs.push_back(run);
+    }
+    fclose(sink);
+    for (const std::string& path : paths)
+        std::remove(path.c_str());
+
+    printf("{\n  \"files\": %zu,\n  \"seconds_per_file\": %.1f,\n", num_files, seconds);
+    printf("  \"sequential\": {\"wall_s\": %.3f, \"files_per_sec\": %.2f, \"audio_x_realtime\": %.1f},\n",
+        sequential_s, num_files / sequential_s, runs[0].stats.audio_seconds / sequential_s);
+    for (size_t k = 0; k < runs.size(); k++)
+        print_pipeline(runs[k].name.c_str(), runs[k].stats, runs[k].match, k + 1 == runs.size());
+    printf("}\n");
+    return 0;
+}
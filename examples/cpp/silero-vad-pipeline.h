@@ -0,0 +1,405 @@
+#ifndef SILERO_VAD_PIPELINE_H_
+#define SILERO_VAD_PIPELINE_H_
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-multichannel.h"
+#include "wav.h"
+
+// Occupancy and stall times of one BoundedQueue.
+struct VadQueueStats {
+    size_t capacity = 0;
+    size_t pushes = 0;
+    size_t max_depth = 0;
+    double depth_sum = 0.0;       // Depth seen by each push, including the pushed item
+    double push_wait_s = 0.0;     // Producers blocked because the queue was full
+    double pop_wait_s = 0.0;      // Consumers blocked because the queue was empty
+
+    double mean_depth() const { return pushes ? depth_sum / pushes : 0.0; }
+};
+
+// BoundedQueue class: blocking FIFO of at most capacity items between two pipeline stages.
+// push() waits while the queue is full and pop() while it is empty; the time spent waiting
+// on each side is recorded. close() wakes everybody: pushes then fail and pops drain what
+// is left.
+template <typename T>
+class BoundedQueue {
+private:
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    std::deque<T> items;
+    size_t capacity;
+    bool closed = false;
+    VadQueueStats _stats;
+
+    typedef std::chrono::steady_clock Clock;
+
+public:
+    explicit BoundedQueue(size_t Capacity) : capacity(Capacity > 0 ? Capacity : 1) {
+        _stats.capacity = capacity;
+    }
+
+    // Returns false if the queue was closed.
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (items.size() >= capacity && !closed) {
+            Clock::time_point t = Clock::now();
+            not_full.wait(lock, [this] { return items.size() < capacity || closed; });
+            _stats.push_wait_s += std::chrono::duration<double>(Clock::now() - t).count();
+        }
+        if (closed)
+            return false;
+        items.push_back(std::move(item));
+        _stats.pushes++;
+        _stats.depth_sum += items.size();
+        _stats.max_depth = std::max(_stats.max_depth, items.size());
+        lock.unlock();
+        not_empty.notify_one();
+        return true;
+    }
+
+    // Returns false once the queue is closed and empty.
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (items.empty() && !closed) {
+            Clock::time_point t = Clock::now();
+            not_empty.wait(lock, [this] { return !items.empty() || closed; });
+            _stats.pop_wait_s += std::chrono::duration<double>(Clock::now() - t).count();
+        }
+        if (items.empty())
+            return false;
+        item = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+
+    VadQueueStats stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return _stats;
+    }
+};
+
+// Settings of a VadPipeline. The segmentation parameters match VadIterator.
+struct VadPipelineOptions {
+    size_t decode_threads = 1;
+    size_t infer_threads = 0;        // 0: one per hardware thread
+    size_t decoded_queue = 4;        // Opened files waiting for inference
+    size_t prefetch_samples = 1 << 20;  // Decoded ahead per waiting file (all channels); the worker reads the rest
+    size_t result_queue = 64;        // Results waiting for the emit stage
+
+    int sample_rate = 16000;         // Model rate; files at other rates are resampled
+    float threshold = 0.5f;
+    int min_silence_duration_ms = 100;
+    int speech_pad_ms = 30;
+    int min_speech_duration_ms = 250;
+    float max_speech_duration_s = std::numeric_limits<float>::infinity();
+};
+
+// Result of one input file.
+struct VadFileResult {
+    size_t index = 0;                // Position in the input list
+    std::string path;
+    int file_sample_rate = 0;
+    int num_channels = 0;
+    double audio_seconds = 0.0;
+    std::vector<std::vector<timestamp_t>> speech;   // Per channel, in samples at the model rate
+    std::string error;               // Empty on success
+
+    bool ok() const { return error.empty(); }
+};
+
+// Work and idle time of one stage.
+struct VadStageStats {
+    size_t threads = 0;
+    size_t items = 0;
+    double busy_s = 0.0;             // Summed over the stage's threads
+};
+
+struct VadPipelineStats {
+    double wall_s = 0.0;
+    size_t files = 0;
+    size_t failures = 0;
+    double audio_seconds = 0.0;
+    VadStageStats decode, infer, emit;
+    VadQueueStats decoded_queue, result_queue;
+    std::vector<std::string> emit_errors;   // "path: message" for each emit call that threw
+};
+
+// VadPipeline class: offline VAD over many files in three overlapped stages.
+//
+//   decode  (decode_threads)  opens a WAV file and converts its first prefetch_samples to float
+//   infer   (infer_threads)   runs the VAD over the file in one-second blocks, reading what was
+//                             not prefetched itself; all workers share one model
+//   emit    (1 thread)        hands the results to the caller, in input order
+//
+// The stages are connected by BoundedQueues, so the next files are read and converted while
+// the current ones run through the model. Blocks are freed as soon as they are fed, so memory
+// is bounded by decoded_queue * prefetch_samples plus a block per worker, however long the
+// files are. A file that cannot be read or processed yields a result with an error, and an
+// emit call that throws is recorded in emit_errors; the other files are not affected.
+class VadPipeline {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    // An opened file: up to prefetch_samples of it decoded in blocks, the rest still in the
+    // reader. A block holds frames of every channel, plane after plane.
+    struct DecodedFile {
+        size_t index = 0;
+        int sample_rate = 0;
+        size_t num_channels = 0;
+        size_t block_frames = 0;
+        std::deque<std::vector<float>> blocks;
+        std::unique_ptr<wav::WavStreamReader> reader;   // Null once the whole file is in blocks
+        std::string error;
+    };
+
+    std::shared_ptr<VadModel> model;
+    VadPipelineOptions options;
+
+    static double seconds_since(Clock::time_point t) {
+        return std::chrono::duration<double>(Clock::now() - t).count();
+    }
+
+    // Reads up to frames frames into block, plane after plane. Returns the frames read.
+    static size_t read_block(wav::WavStreamReader& reader, size_t channels, size_t frames, std::vector<float>& block) {
+        block.resize(channels * frames);
+        std::vector<float*> planes(channels);
+        for (size_t c = 0; c < channels; c++)
+            planes[c] = block.data() + c * frames;
+        const size_t n = reader.ReadChannels(planes.data(), frames);
+        if (n < frames) {
+            for (size_t c = 1; c < channels; c++)
+                std::copy(planes[c], planes[c] + n, block.data() + c * n);
+        }
+        block.resize(channels * n);
+        return n;
+    }
+
+    // Opens the file and decodes its first prefetch_samples, one second per block.
+    void decode(const std::string& path, DecodedFile& out) const {
+        std::unique_ptr<wav::WavStreamReader> reader(new wav::WavStreamReader());
+        if (!reader->Open(path)) {
+            out.error = "cannot read WAV file";
+            return;
+        }
+        out.sample_rate = reader->sample_rate();
+        out.num_channels = static_cast<size_t>(reader->num_channel());
+        out.block_frames = static_cast<size_t>(std::max(reader->sample_rate(), 1));
+        for (size_t decoded = 0; decoded < options.prefetch_samples; ) {
+            std::vector<float> block;
+            const size_t n = read_block(*reader, out.num_channels, out.block_frames, block);
+            if (n > 0)
+                out.blocks.push_back(std::move(block));
+            if (n < out.block_frames) {
+                reader.reset();
+                break;
+            }
+            decoded += n * out.num_channels;
+        }
+        out.reader = std::move(reader);
+    }
+
+    // Feeds the file block by block: the prefetched blocks first, each freed once fed, then
+    // the rest of the file straight from the reader into one reused block.
+    void infer(DecodedFile& in, VadFileResult& out) const {
+        const VadPipelineOptions& o = options;
+        const size_t channels = in.num_channels;
+        out.num_channels = static_cast<int>(channels);
+        out.speech.resize(channels);
+        std::unique_ptr<MultiChannelVad> batched;
+        std::vector<std::unique_ptr<VadIterator>> single;
+        if (channels > 1 && in.sample_rate == o.sample_rate) {
+            // All channels batched into one Run per window.
+            batched.reset(new MultiChannelVad(model, static_cast<int>(channels), o.sample_rate, 32, o.threshold,
+                o.min_silence_duration_ms, o.speech_pad_ms, o.min_speech_duration_ms, o.max_speech_duration_s));
+        } else {
+            for (size_t c = 0; c < channels; c++) {
+                single.emplace_back(new VadIterator(model, o.sample_rate, 32, o.threshold, o.min_silence_duration_ms,
+                    o.speech_pad_ms, o.min_speech_duration_ms, o.max_speech_duration_s));
+                single.back()->set_input_sample_rate(in.sample_rate);
+            }
+        }
+        std::vector<float> block;
+        std::vector<const float*> planes(channels);
+        size_t frames = 0;
+        for (;;) {
+            if (!in.blocks.empty()) {
+                block.swap(in.blocks.front());
+                in.blocks.pop_front();
+            } else if (!in.reader || read_block(*in.reader, channels, in.block_frames, block) == 0) {
+                break;
+            }
+            const size_t n = block.size() / channels;
+            for (size_t c = 0; c < channels; c++)
+                planes[c] = block.data() + c * n;
+            if (batched) {
+                batched->feed_planar(planes.data(), n);
+            } else {
+                for (size_t c = 0; c < channels; c++)
+                    single[c]->feed(planes[c], n);
+            }
+            frames += n;
+        }
+        in.reader.reset();
+        out.audio_seconds = static_cast<double>(frames) / in.sample_rate;
+        for (size_t c = 0; c < channels; c++) {
+            if (batched) {
+                batched->flush();
+                out.speech[c] = batched->get_speech_timestamps(static_cast<int>(c));
+            } else {
+                single[c]->flush();
+                out.speech[c] = single[c]->get_speech_timestamps();
+            }
+        }
+    }
+
+public:
+    VadPipeline(std::shared_ptr<VadModel> Model, const VadPipelineOptions& Options = VadPipelineOptions())
+        : model(std::move(Model)), options(Options)
+    {
+        if (options.infer_threads == 0)
+            options.infer_threads = std::max(1u, std::thread::hardware_concurrency());
+        if (options.decode_threads == 0)
+            options.decode_threads = 1;
+    }
+
+    // Runs every file through the pipeline and calls emit once per file, in input order, on
+    // the emit thread. Returns when all results have been emitted.
+    VadPipelineStats run(const std::vector<std::string>& paths,
+        const std::function<void(const VadFileResult&)>& emit) {
+        VadPipelineStats stats;
+        stats.decode.threads = options.decode_threads;
+        stats.infer.threads = options.infer_threads;
+        stats.emit.threads = 1;
+        std::mutex stats_mutex;
+
+        BoundedQueue<std::unique_ptr<DecodedFile>> decoded(options.decoded_queue);
+        BoundedQueue<std::unique_ptr<VadFileResult>> results(options.result_queue);
+        std::atomic<size_t> next_file{ 0 };
+        std::atomic<size_t> decoders_left{ options.decode_threads };
+        std::atomic<size_t> workers_left{ options.infer_threads };
+        Clock::time_point start = Clock::now();
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < options.decode_threads; t++) {
+            threads.emplace_back([&]() {
+                VadStageStats local;
+                for (size_t i; (i = next_file++) < paths.size(); ) {
+                    Clock::time_point t0 = Clock::now();
+                    std::unique_ptr<DecodedFile> file(new DecodedFile());
+                    file->index = i;
+                    try {
+                        decode(paths[i], *file);
+                    } catch (const std::exception& e) {
+                        file->error = e.what();
+                        file->blocks.clear();
+                        file->reader.reset();
+                    }
+                    local.busy_s += seconds_since(t0);
+                    local.items++;
+                    if (!decoded.push(std::move(file)))
+                        break;
+                }
+                if (--decoders_left == 0)
+                    decoded.close();
+                std::lock_guard<std::mutex> lock(stats_mutex);
+                stats.decode.items += local.items;
+                stats.decode.busy_s += local.busy_s;
+            });
+        }
+        for (size_t t = 0; t < options.infer_threads; t++) {
+            threads.emplace_back([&]() {
+                VadStageStats local;
+                for (std::unique_ptr<DecodedFile> file; decoded.pop(file); ) {
+                    Clock::time_point t0 = Clock::now();
+                    std::unique_ptr<VadFileResult> result(new VadFileResult());
+                    result->index = file->index;
+                    result->path = paths[file->index];
+                    result->file_sample_rate = file->sample_rate;
+                    result->error = file->error;
+                    if (result->ok()) {
+                        try {
+                            infer(*file, *result);
+                        } catch (const std::exception& e) {
+                            result->error = e.what();
+                        }
+                    }
+                    file.reset();
+                    local.busy_s += seconds_since(t0);
+                    local.items++;
+                    results.push(std::move(result));
+                }
+                if (--workers_left == 0)
+                    results.close();
+                std::lock_guard<std::mutex> lock(stats_mutex);
+                stats.infer.items += local.items;
+                stats.infer.busy_s += local.busy_s;
+            });
+        }
+
+        // Emit stage (this thread): restores the input order.
+        std::map<size_t, std::unique_ptr<VadFileResult>> early;
+        size_t next_emit = 0;
+        try {
+            for (std::unique_ptr<VadFileResult> result; results.pop(result); ) {
+                early[result->index] = std::move(result);
+                Clock::time_point t0 = Clock::now();
+                for (auto it = early.begin(); it != early.end() && it->first == next_emit; it = early.erase(it)) {
+                    const VadFileResult& r = *it->second;
+                    stats.files++;
+                    stats.failures += !r.ok();
+                    stats.audio_seconds += r.audio_seconds;
+                    try {
+                        emit(r);
+                    } catch (const std::exception& e) {
+                        stats.emit_errors.push_back(r.path + ": " + e.what());
+                    }
+                    next_emit++;
+                }
+                stats.emit.busy_s += seconds_since(t0);
+            }
+        } catch (...) {
+            // emit threw something other than a std::exception: stop the other stages before
+            // passing it on.
+            decoded.close();
+            results.close();
+            for (std::thread& t : threads)
+                t.join();
+            throw;
+        }
+        for (std::thread& t : threads)
+            t.join();
+        stats.emit.items = stats.files;
+        stats.wall_s = seconds_since(start);
+        stats.decoded_queue = decoded.stats();
+        stats.result_queue = results.stats();
+        return stats;
+    }
+};
+
+#endif  // SILERO_VAD_PIPELINE_H_
@@ -0,0 +1,162 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Accuracy vs. throughput of the reduced-precision models against fp32, on the same audio.
+//
+// For every precision whose model file exists in --models, it reports:
+//   prob_mae / prob_max_err : mean / max absolute difference of per-window probabilities
+//   frame_agreement         : share of windows with the same speech/non-speech label
+//                             (from the final segments)
+//   segments                : number of speech segments found
+//   windows_per_sec         : single-threaded throughput
+//   speedup                 : windows_per_sec relative to fp32
+//   realtime_streams_per_core: windows_per_sec / windows per second of audio
+//
+// The audio is synthetic unless --wav (16 kHz) is given. Output is JSON.
+//
+// Usage: ./precision [--models ../../src/silero_vad/data] [--wav file.wav] [--seconds 120]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-testaudio.h"
+#include "wav.h"
+
+namespace {
+
+struct PrecisionRun {
+    VadPrecision precision;
+    std::vector<float> probs;
+    std::vector<timestamp_t> segments;
+    double windows_per_sec = 0;
+};
+
+// Runs the whole audio window by window, keeping every probability.
+PrecisionRun run_precision(VadPrecision precision, const std::string& model_dir, const std::vector<float>& audio,
+    int window) {
+    PrecisionRun run;
+    run.precision = precision;
+    VadIterator vad(VadModel::get(vad_model_path(model_dir, precision)));
+    run.probs.reserve(audio.size() / window);
+
+    // One short warm-up pass so session set-up does not count.
+    for (size_t i = 0; i + window <= audio.size() && i < static_cast<size_t>(window) * 50; i += window)
+        vad.feed(audio.data() + i, window);
+    vad.reset();
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i + window <= audio.size(); i += window) {
+        vad.feed(audio.data() + i, window);
+        run.probs.push_back(vad.last_speech_prob());
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    vad.flush();
+    run.segments = vad.get_speech_timestamps();
+    run.windows_per_sec = run.probs.size() / elapsed;
+    return run;
+}
+
+// Per-window speech labels from segments.
+std::vector<bool> window_labels(const std::vector<timestamp_t>& segments, size_t num_windows, int window) {
+    std::vector<bool> labels(num_windows, false);
+    for (const timestamp_t& seg : segments) {
+        size_t first = static_cast<size_t>(std::max<int64_t>(0, seg.start)) / window;
+        size_t last = static_cast<size_t>(std::max<int64_t>(0, seg.end)) / window;
+        for (size_t w = first; w < std::min(last, num_windows); w++)
+            labels[w] = true;
+    }
+    return labels;
+}
+
+bool file_exists(const std::basic_string<ORTCHAR_T>& path) {
+    std::string narrow(path.begin(), path.end());
+    FILE* f = fopen(narrow.c_str(), "rb");
+    if (f == NULL)
+        return false;
+    fclose(f);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_dir = "../../src/silero_vad/data";
+    std::string wav_path;
+    double seconds = 120.0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--models") model_dir = argv[i + 1];
+        else if (key == "--wav") wav_path = argv[i + 1];
+        else if (key == "--seconds") seconds = std::stod(argv[i + 1]);
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    const int sample_rate = 16000;
+    const int window = 512;
+
+    std::vector<float> audio;
+    if (wav_path.empty()) {
+        audio = make_test_audio(sample_rate, seconds, 7);
+    } else {
+        wav::WavStreamReader reader(wav_path);
+        if (reader.sample_rate() != sample_rate) {
+            fprintf(stderr, "%s: expected %d Hz audio\n", wav_path.c_str(), sample_rate);
+            return 1;
+        }
+        std::vector<float> block(sample_rate);
+        for (size_t n; (n = reader.Read(block.data(), block.size())) > 0; )
+            audio.insert(audio.end(), block.begin(), block.begin() + n);
+    }
+
+    const VadPrecision precisions[] = { VAD_PRECISION_FP32, VAD_PRECISION_FP16, VAD_PRECISION_INT8 };
+    std::vector<PrecisionRun> runs;
+    for (VadPrecision p : precisions) {
+        if (!file_exists(vad_model_path(model_dir, p))) {
+            fprintf(stderr, "skipping %s: model not found in %s\n", vad_precision_name(p), model_dir.c_str());
+            continue;
+        }
+        runs.push_back(run_precision(p, model_dir, audio, window));
+    }
+    if (runs.empty() || runs[0].precision != VAD_PRECISION_FP32) {
+        fprintf(stderr, "the fp32 model is required as the reference\n");
+        return 1;
+    }
+
+    const PrecisionRun& ref = runs[0];
+    const size_t num_windows = ref.probs.size();
+    const std::vector<bool> ref_labels = window_labels(ref.segments, num_windows, window);
+    const double windows_per_audio_sec = static_cast<double>(sample_rate) / window;
+
+    printf("{\n  \"audio_seconds\": %.1f,\n  \"windows\": %zu,\n  \"modes\": {\n",
+        static_cast<double>(audio.size()) / sample_rate, num_windows);
+    for (size_t r = 0; r < runs.size(); r++) {
+        const PrecisionRun& run = runs[r];
+        double sum_err = 0.0, max_err = 0.0;
+        for (size_t w = 0; w < num_windows; w++) {
+            double err = std::fabs(static_cast<double>(run.probs[w]) - ref.probs[w]);
+            sum_err += err;
+            max_err = std::max(max_err, err);
+        }
+        std::vector<bool> labels = window_labels(run.segments, num_windows, window);
+        size_t agree = 0;
+        for (size_t w = 0; w < num_windows; w++)
+            agree += labels[w] == ref_labels[w];
+
+        printf("    \"%s\": {\"prob_mae\": %.6f, \"prob_max_err\": %.6f, \"frame_agreement\": %.4f, \"segments\": %zu, "
+            "\"windows_per_sec\": %.1f, \"speedup\": %.2f, \"realtime_streams_per_core\": %.0f}%s\n",
+            vad_precision_name(run.precision), sum_err / num_windows, max_err,
+            static_cast<double>(agree) / num_windows, run.segments.size(), run.windows_per_sec,
+            run.windows_per_sec / ref.windows_per_sec, run.windows_per_sec / windows_per_audio_sec,
+            r + 1 < runs.size() ? "," : "");
+    }
+    printf("  }\n}\n");
+    return 0;
+}
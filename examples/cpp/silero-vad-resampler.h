@@ -0,0 +1,152 @@
+#ifndef SILERO_VAD_RESAMPLER_H_
+#define SILERO_VAD_RESAMPLER_H_
+
+// Streaming polyphase resampler for feeding 44.1/48 kHz (or any other rate) audio to the
+// 8/16 kHz model without an external conversion step.
+//
+// The rate ratio is reduced to L/M (e.g. 48000 -> 16000 is 1/3, 44100 -> 16000 is
+// 160/441). Output sample n sits at input position n * M / L. It is a dot product of
+// 2 * half_width input samples around that position with one of L precomputed phases of a
+// Kaiser-windowed sinc low-pass. The cutoff is at 0.9 x the lower Nyquist frequency, so
+// there is no aliasing into the band the model looks at. Each phase is normalized to unit
+// DC gain, and the dot product uses the SIMD kernels from silero-vad-dot.h.
+//
+// The filter is centred on the output position, so there is no group delay. The price is
+// a lookahead of about half_width input samples (0.1 to 1 ms): each output waits for them,
+// and flush() pushes out the tail. Input may arrive in chunks of any size; the history
+// and phase carry over between calls.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "silero-vad-dot.h"
+
+class StreamingResampler {
+public:
+    // half_width: zero crossings of the sinc on each side (per output sample when
+    // upsampling, scaled by M/L when downsampling). 16 keeps the stop band below -80 dB.
+    StreamingResampler(int in_rate, int out_rate, int half_width = 16)
+        : in_rate(in_rate), out_rate(out_rate)
+    {
+        if (in_rate <= 0 || out_rate <= 0 || half_width <= 0)
+            throw std::invalid_argument("StreamingResampler: rates and half_width must be positive");
+        int g = gcd(in_rate, out_rate);
+        up = out_rate / g;
+        down = in_rate / g;
+        const double ratio = static_cast<double>(up) / down;
+        const double cutoff = 0.5 * 0.9 * (ratio < 1.0 ? ratio : 1.0);  // cycles per input sample
+        half_taps = ratio < 1.0 ? static_cast<int>(std::ceil(half_width / ratio)) : half_width;
+        taps = 2 * half_taps;
+
+        // Phase p serves outputs at input position i + p / L. Coefficient k multiplies
+        // x[i - half_taps + 1 + k] and sits at distance d = k - half_taps + 1 - p / L.
+        const double beta = 8.6;
+        const double pi = 3.14159265358979323846;
+        coeffs.resize(static_cast<size_t>(up) * taps);
+        for (int p = 0; p < up; p++) {
+            float* row = coeffs.data() + static_cast<size_t>(p) * taps;
+            double sum = 0.0;
+            for (int k = 0; k < taps; k++) {
+                double d = k - half_taps + 1 - static_cast<double>(p) / up;
+                double x = 2.0 * cutoff * d;
+                double sinc = x == 0.0 ? 1.0 : std::sin(pi * x) / (pi * x);
+                double w = d / half_taps;
+                double window = std::fabs(w) >= 1.0 ? 0.0 : bessel_i0(beta * std::sqrt(1.0 - w * w)) / bessel_i0(beta);
+                row[k] = static_cast<float>(sinc * window);
+                sum += row[k];
+            }
+            for (int k = 0; k < taps; k++)
+                row[k] = static_cast<float>(row[k] / sum);
+        }
+        reset();
+    }
+
+    // Clears the history and phase, as for a new stream.
+    void reset() {
+        history.assign(half_taps - 1, 0.0f);  // zeros before the first sample
+        position = 0;
+        phase = 0;
+        flushed = false;
+    }
+
+    // Upper bound on the outputs produced for num_samples more inputs.
+    size_t max_output(size_t num_samples) const {
+        return static_cast<size_t>((static_cast<uint64_t>(num_samples + taps) * up) / down) + 1;
+    }
+
+    // Resamples num_samples input samples and appends the outputs that are complete to `out`.
+    void process(const float* samples, size_t num_samples, std::vector<float>& out) {
+        if (flushed)
+            reset();
+        history.insert(history.end(), samples, samples + num_samples);
+        drain(out);
+    }
+
+    // Pushes out the outputs still waiting for lookahead, treating the input as ending
+    // here. The next process() starts a new stream.
+    void flush(std::vector<float>& out) {
+        if (flushed)
+            return;
+        history.insert(history.end(), half_taps, 0.0f);
+        drain(out);
+        flushed = true;
+    }
+
+    int input_rate() const { return in_rate; }
+    int output_rate() const { return out_rate; }
+    int taps_per_output() const { return taps; }
+
+private:
+    int in_rate, out_rate;
+    int up = 1, down = 1;             // out/in = up/down, reduced
+    int half_taps = 0, taps = 0;
+    std::vector<float> coeffs;        // [up][taps]
+    std::vector<float> history;       // history[0] is input index position - half_taps + 1
+    size_t position = 0;              // input index of the next output, relative to history
+    int phase = 0;                    // fractional part of that position, in 1/up
+    bool flushed = false;
+
+    // Produces every output whose window lies inside `history`, then drops the samples
+    // no later output needs.
+    void drain(std::vector<float>& out) {
+        vad_dot::DotFn dot = vad_dot::ActiveDot().fn;
+        const size_t start = out.size();
+        out.resize(start + max_output(history.size()));
+        size_t produced = start;
+        while (position + taps <= history.size()) {
+            out[produced++] = dot(coeffs.data() + static_cast<size_t>(phase) * taps, history.data() + position, taps);
+            phase += down;
+            position += phase / up;
+            phase %= up;
+        }
+        out.resize(produced);
+        size_t consumed = position < history.size() ? position : history.size();
+        history.erase(history.begin(), history.begin() + consumed);
+        position -= consumed;
+    }
+
+    static int gcd(int a, int b) {
+        while (b != 0) {
+            int t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    static double bessel_i0(double x) {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 50; k++) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < sum * 1e-12)
+                break;
+        }
+        return sum;
+    }
+};
+
+#endif  // SILERO_VAD_RESAMPLER_H_
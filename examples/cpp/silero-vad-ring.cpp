@@ -0,0 +1,221 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Live-capture ingest: push latency of VadRingBuffer against a mutex-guarded queue.
+//
+// A producer thread plays the audio callback. It pushes --frame-ms frames at --speed times
+// real time while a consumer thread runs VadIterator on the windows. --load-threads busy
+// threads compete for the CPUs. For each ingest path it reports:
+//   push_ns          : p50 / p99 / p99.9 / max time of one push call on the producer
+//   overruns         : frames dropped because the queue was full
+//   underruns        : consumer polls that found no whole window (the consumer then waits a
+//                      quarter frame, as a worker would)
+//   segments_match   : the segments equal VadIterator::process() on the same audio
+//                      (expected whenever nothing was dropped)
+// Output is JSON.
+//
+// Usage: ./ring [--model silero_vad.onnx] [--seconds 60] [--frame-ms 10] [--speed 20]
+//               [--load-threads N] [--capacity-ms 500]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-ring.h"
+#include "silero-vad-testaudio.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct RunResult {
+    std::vector<double> push_ns;
+    uint64_t overruns = 0;
+    uint64_t underruns = 0;
+    size_t capacity = 0;
+    bool segments_match = false;
+};
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty())
+        return 0.0;
+    size_t k = std::min(v.size() - 1, static_cast<size_t>(p * (v.size() - 1) + 0.5));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+// The capture callback: pushes the audio frame by frame at the paced rate and times every push.
+template <typename Push>
+void produce(const std::vector<float>& audio, size_t frame, double frame_seconds, Push&& push,
+    std::vector<double>& push_ns) {
+    push_ns.reserve(audio.size() / frame + 1);
+    Clock::time_point next = Clock::now();
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(frame_seconds));
+    for (size_t pos = 0; pos < audio.size(); pos += frame) {
+        std::this_thread::sleep_until(next);
+        next += period;
+        size_t n = std::min(frame, audio.size() - pos);
+        Clock::time_point t = Clock::now();
+        push(audio.data() + pos, n);
+        push_ns.push_back(std::chrono::duration<double, std::nano>(Clock::now() - t).count());
+    }
+}
+
+RunResult run_ring(std::shared_ptr<VadModel> model, const std::vector<float>& audio, size_t frame,
+    double frame_seconds, size_t capacity, const std::vector<timestamp_t>& expected) {
+    RunResult r;
+    const std::chrono::duration<double> idle(frame_seconds / 4);
+    VadIterator vad(model);
+    VadRingBuffer ring(capacity, vad.window_samples(), vad.effective_window_samples() - vad.window_samples());
+    std::atomic<bool> done{ false };
+    std::thread consumer([&]() {
+        for (;;) {
+            if (const float* view = ring.peek_window()) {
+                vad.feed_window(view);
+                ring.release_window();
+            } else if (done.load(std::memory_order_acquire) && ring.available() < ring.window_samples()) {
+                break;
+            } else {
+                std::this_thread::sleep_for(idle);
+            }
+        }
+    });
+    produce(audio, frame, frame_seconds, [&](const float* p, size_t n) { ring.push(p, n); }, r.push_ns);
+    done.store(true, std::memory_order_release);
+    consumer.join();
+    vad.flush();
+    r.overruns = ring.overruns();
+    r.underruns = ring.underruns();
+    r.capacity = ring.capacity();
+    r.segments_match = vad.get_speech_timestamps() == expected;
+    return r;
+}
+
+// What callers had to build before: a std::mutex around a growing sample vector.
+RunResult run_mutex(std::shared_ptr<VadModel> model, const std::vector<float>& audio, size_t frame,
+    double frame_seconds, const std::vector<timestamp_t>& expected) {
+    RunResult r;
+    const std::chrono::duration<double> idle(frame_seconds / 4);
+    VadIterator vad(model);
+    const size_t window = vad.window_samples();
+    std::mutex mutex;
+    std::vector<float> queue;
+    size_t read_pos = 0;
+    std::atomic<bool> done{ false };
+    std::thread consumer([&]() {
+        std::vector<float> block(window);
+        for (;;) {
+            bool got = false, finished = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (queue.size() - read_pos >= window) {
+                    std::copy(queue.begin() + read_pos, queue.begin() + read_pos + window, block.begin());
+                    read_pos += window;
+                    got = true;
+                    if (read_pos > 16 * window) {
+                        queue.erase(queue.begin(), queue.begin() + read_pos);
+                        read_pos = 0;
+                    }
+                } else {
+                    finished = done.load(std::memory_order_acquire);
+                }
+            }
+            if (got) {
+                vad.feed(block.data(), window);
+            } else if (finished) {
+                break;
+            } else {
+                r.underruns++;
+                std::this_thread::sleep_for(idle);
+            }
+        }
+    });
+    produce(audio, frame, frame_seconds, [&](const float* p, size_t n) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.insert(queue.end(), p, p + n);
+    }, r.push_ns);
+    done.store(true, std::memory_order_release);
+    consumer.join();
+    vad.flush();
+    r.segments_match = vad.get_speech_timestamps() == expected;
+    return r;
+}
+
+void print_run(const char* name, const RunResult& r, bool last) {
+    printf("  \"%s\": {\"pushes\": %zu, \"push_ns\": {\"p50\": %.0f, \"p99\": %.0f, \"p999\": %.0f, \"max\": %.0f}, "
+        "\"overruns\": %llu, \"underruns\": %llu, \"segments_match\": %s}%s\n",
+        name, r.push_ns.size(), percentile(r.push_ns, 0.50), percentile(r.push_ns, 0.99),
+        percentile(r.push_ns, 0.999), percentile(r.push_ns, 1.0), static_cast<unsigned long long>(r.overruns),
+        static_cast<unsigned long long>(r.underruns), r.segments_match ? "true" : "false", last ? "" : ",");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = "../../src/silero_vad/data/silero_vad.onnx";
+    double seconds = 60.0;
+    double frame_ms = 10.0;
+    double speed = 20.0;
+    double capacity_ms = 500.0;
+    int load_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--model") model_arg = argv[i + 1];
+        else if (key == "--seconds") seconds = std::stod(argv[i + 1]);
+        else if (key == "--frame-ms") frame_ms = std::stod(argv[i + 1]);
+        else if (key == "--speed") speed = std::stod(argv[i + 1]);
+        else if (key == "--load-threads") load_threads = std::max(0, std::stoi(argv[i + 1]));
+        else if (key == "--capacity-ms") capacity_ms = std::stod(argv[i + 1]);
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    const int sample_rate = 16000;
+    const size_t window = 512;
+    const size_t frame = static_cast<size_t>(frame_ms * sample_rate / 1000);
+    const double frame_seconds = frame_ms / 1000.0 / speed;
+    const size_t capacity = static_cast<size_t>(capacity_ms * sample_rate / 1000);
+
+    // Whole windows only, so the offline reference sees exactly the samples the consumers run.
+    std::vector<float> audio = make_test_audio(sample_rate, seconds, 21);
+    audio.resize(audio.size() / window * window);
+    std::shared_ptr<VadModel> model = VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end()));
+    std::vector<timestamp_t> expected;
+    {
+        VadIterator vad(model);
+        vad.process(audio);
+        expected = vad.get_speech_timestamps();
+    }
+
+    std::atomic<bool> stop{ false };
+    std::vector<std::thread> load;
+    for (int i = 0; i < load_threads; i++) {
+        load.emplace_back([&stop]() {
+            volatile uint64_t x = 0;
+            while (!stop.load(std::memory_order_relaxed))
+                x = x + 1;
+        });
+    }
+    RunResult ring = run_ring(model, audio, frame, frame_seconds, capacity, expected);
+    RunResult locked = run_mutex(model, audio, frame, frame_seconds, expected);
+    stop.store(true);
+    for (std::thread& t : load)
+        t.join();
+
+    printf("{\n  \"audio_seconds\": %.1f,\n  \"frame_samples\": %zu,\n  \"speed\": %.1f,\n  \"load_threads\": %d,\n"
+        "  \"ring_capacity\": %zu,\n",
+        static_cast<double>(audio.size()) / sample_rate, frame, speed, load_threads, ring.capacity);
+    print_run("ring", ring, false);
+    print_run("mutex_queue", locked, true);
+    printf("}\n");
+    return 0;
+}
@@ -0,0 +1,151 @@
+#ifndef SILERO_VAD_RING_H_
+#define SILERO_VAD_RING_H_
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+// VadRingBuffer class: wait-free single-producer/single-consumer sample queue between an
+// audio capture callback and a VAD worker.
+//
+// The producer pushes frames of any size and never blocks, locks or allocates. The consumer
+// takes exact model inputs: the context (last context_samples of the previous window,
+// zeros at the start) followed by the next window, effective_window_size samples in all.
+// A view points straight into the ring unless it wraps past the end, in which case it is
+// assembled in a scratch buffer. The context samples stay reserved until the next window
+// is released, so the producer never overwrites a view that is in use.
+//
+// Producer and consumer positions sit on separate cache lines. Each side also keeps a
+// cached copy of the other's position, so the shared lines are only read when the cached
+// value does not allow the operation.
+class VadRingBuffer {
+private:
+    static const size_t kCacheLine = 64;
+
+    // Written by the producer.
+    struct alignas(kCacheLine) ProducerSide {
+        std::atomic<uint64_t> head{ 0 };        // Samples written (plus the initial context)
+        uint64_t cached_tail = 0;
+        std::atomic<uint64_t> overruns{ 0 };
+        std::atomic<uint64_t> overrun_samples{ 0 };
+    };
+    // Written by the consumer.
+    struct alignas(kCacheLine) ConsumerSide {
+        std::atomic<uint64_t> tail{ 0 };        // Start of the next window
+        uint64_t cached_head = 0;
+        std::atomic<uint64_t> underruns{ 0 };
+    };
+
+    ProducerSide producer;
+    ConsumerSide consumer;
+    alignas(kCacheLine) std::vector<float> ring;
+    std::vector<float> scratch;                 // Views that wrap around the end
+    size_t mask;
+    size_t window_size_samples;
+    size_t context_samples;
+    size_t effective_window_size;
+
+public:
+    // capacity_samples is rounded up to a power of two; it must hold at least the context
+    // plus two windows.
+    VadRingBuffer(size_t capacity_samples, int window_size_samples = 512, int context_samples = 64)
+        : window_size_samples(window_size_samples), context_samples(context_samples),
+          effective_window_size(window_size_samples + context_samples)
+    {
+        size_t capacity = 1;
+        while (capacity < capacity_samples)
+            capacity <<= 1;
+        if (capacity < effective_window_size + window_size_samples)
+            throw std::invalid_argument("VadRingBuffer: capacity must hold the context and two windows");
+        ring.assign(capacity, 0.0f);
+        scratch.assign(effective_window_size, 0.0f);
+        mask = capacity - 1;
+        reset();
+    }
+
+    // Empties the ring and zeroes the context. Only call it while neither side is active.
+    void reset() {
+        std::fill(ring.begin(), ring.end(), 0.0f);
+        producer.head.store(context_samples, std::memory_order_relaxed);
+        producer.cached_tail = context_samples;
+        consumer.tail.store(context_samples, std::memory_order_relaxed);
+        consumer.cached_head = context_samples;
+        producer.overruns.store(0, std::memory_order_relaxed);
+        producer.overrun_samples.store(0, std::memory_order_relaxed);
+        consumer.underruns.store(0, std::memory_order_relaxed);
+    }
+
+    // ----- Producer -----
+
+    // Appends num_samples samples. If they do not fit, the whole frame is dropped and counted
+    // as an overrun (the consumer fell behind); returns false in that case. Wait-free.
+    bool push(const float* samples, size_t num_samples) {
+        const uint64_t head = producer.head.load(std::memory_order_relaxed);
+        const size_t usable = ring.size() - context_samples;
+        if (head + num_samples - producer.cached_tail > usable) {
+            producer.cached_tail = consumer.tail.load(std::memory_order_acquire);
+            if (head + num_samples - producer.cached_tail > usable) {
+                producer.overruns.fetch_add(1, std::memory_order_relaxed);
+                producer.overrun_samples.fetch_add(num_samples, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        const size_t pos = static_cast<size_t>(head) & mask;
+        const size_t first = std::min(num_samples, ring.size() - pos);
+        std::memcpy(ring.data() + pos, samples, first * sizeof(float));
+        std::memcpy(ring.data(), samples + first, (num_samples - first) * sizeof(float));
+        producer.head.store(head + num_samples, std::memory_order_release);
+        return true;
+    }
+
+    // ----- Consumer -----
+
+    // Returns the next [context | window] view of effective_window_size() samples, or NULL
+    // if a whole window has not arrived yet (counted as an underrun). The view stays valid
+    // until release_window().
+    const float* peek_window() {
+        const uint64_t tail = consumer.tail.load(std::memory_order_relaxed);
+        if (consumer.cached_head - tail < window_size_samples) {
+            consumer.cached_head = producer.head.load(std::memory_order_acquire);
+            if (consumer.cached_head - tail < window_size_samples) {
+                consumer.underruns.fetch_add(1, std::memory_order_relaxed);
+                return NULL;
+            }
+        }
+        const size_t start = static_cast<size_t>(tail - context_samples) & mask;
+        if (start + effective_window_size <= ring.size())
+            return ring.data() + start;
+        const size_t first = ring.size() - start;
+        std::memcpy(scratch.data(), ring.data() + start, first * sizeof(float));
+        std::memcpy(scratch.data() + first, ring.data(), (effective_window_size - first) * sizeof(float));
+        return scratch.data();
+    }
+
+    // Consumes the window returned by peek_window(). Its last context_samples samples become
+    // the context of the next window.
+    void release_window() {
+        const uint64_t tail = consumer.tail.load(std::memory_order_relaxed);
+        consumer.tail.store(tail + window_size_samples, std::memory_order_release);
+    }
+
+    // Samples pushed but not yet consumed. Exact on the consumer thread; a snapshot elsewhere.
+    size_t available() const {
+        return static_cast<size_t>(producer.head.load(std::memory_order_acquire) -
+            consumer.tail.load(std::memory_order_acquire));
+    }
+
+    // ----- Counters (readable from any thread) -----
+
+    uint64_t overruns() const { return producer.overruns.load(std::memory_order_relaxed); }
+    uint64_t overrun_samples() const { return producer.overrun_samples.load(std::memory_order_relaxed); }
+    uint64_t underruns() const { return consumer.underruns.load(std::memory_order_relaxed); }
+
+    size_t capacity() const { return ring.size(); }
+    size_t window_samples() const { return window_size_samples; }
+    size_t effective_window_samples() const { return effective_window_size; }
+};
+
+#endif  // SILERO_VAD_RING_H_
@@ -0,0 +1,72 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Measures VadScheduler throughput (windows/sec) with 1..N worker threads sharing one model.
+//
+// Usage: ./scaling [model_path] [num_streams] [seconds_per_stream] [max_workers]
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+
+#include "silero-vad-scheduler.h"
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = argc > 1 ? argv[1] : "../../src/silero_vad/data/silero_vad.onnx";
+    int num_streams = argc > 2 ? std::stoi(argv[2]) : 1000;
+    int seconds = argc > 3 ? std::stoi(argv[3]) : 10;
+    int max_workers = argc > 4 ? std::stoi(argv[4]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    max_workers = std::max(1, max_workers);
+    const int sample_rate = 16000;
+    const int chunk = sample_rate / 10;  // streams are fed 100 ms at a time
+
+    // Synthetic audio: 1 s tone bursts over low noise. Streams read it at different offsets.
+    std::vector<float> audio(static_cast<size_t>(sample_rate) * (seconds + 1));
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+    for (size_t i = 0; i < audio.size(); i++) {
+        bool burst = (i / sample_rate) % 2 == 0;
+        audio[i] = noise(rng) + (burst ? 0.3f * std::sin(2.0f * 3.14159265f * 220.0f * i / sample_rate) : 0.0f);
+    }
+
+    auto model = VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end()));
+
+    double base_rate = 0.0;
+    std::cout << "streams=" << num_streams << " seconds/stream=" << seconds << std::endl;
+    std::cout << "workers  windows/sec  speedup  efficiency" << std::endl;
+    // Powers of two below max_workers, then max_workers itself.
+    std::vector<int> worker_counts;
+    for (int workers = 1; workers < max_workers; workers *= 2)
+        worker_counts.push_back(workers);
+    worker_counts.push_back(max_workers);
+    for (int workers : worker_counts) {
+        VadScheduler scheduler(model, workers);
+        std::vector<VadScheduler::Stream*> streams;
+        for (int s = 0; s < num_streams; s++)
+            streams.push_back(scheduler.add_stream());
+
+        auto begin = std::chrono::steady_clock::now();
+        for (int pos = 0; pos + chunk <= seconds * sample_rate; pos += chunk) {
+            for (int s = 0; s < num_streams; s++)
+                scheduler.feed(streams[s], audio.data() + pos + (s * 97) % sample_rate, chunk);
+        }
+        scheduler.drain();
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        double rate = scheduler.windows_processed() / elapsed;
+        if (workers == 1)
+            base_rate = rate;
+        std::cout << std::setw(7) << workers
+            << std::setw(13) << std::fixed << std::setprecision(0) << rate
+            << std::setw(9) << std::setprecision(2) << rate / base_rate
+            << std::setw(11) << std::setprecision(2) << rate / base_rate / workers << std::endl;
+    }
+    return 0;
+}
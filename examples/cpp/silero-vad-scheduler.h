@@ -0,0 +1,231 @@
+#ifndef SILERO_VAD_SCHEDULER_H_
+#define SILERO_VAD_SCHEDULER_H_
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <limits>
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-batch.h"
+
+// VadScheduler class: runs many lightweight VadStreams on a fixed pool of worker threads
+// that all share one VadModel (one Ort::Session).
+//
+// Every worker owns a BatchedVadEngine (its own batch buffers) and a run queue of streams
+// with pending audio. A worker takes up to max_batch streams from its own queue, or steals
+// half of another worker's queue when its own is empty, and runs their windows batched.
+// A stream is in at most one run queue and owned by at most one worker at a time, so its
+// windows are always processed in order and the LSTM state stays correct.
+//
+// feed() may be called from any thread at any time. Speech callbacks run on worker threads.
+class VadScheduler {
+public:
+    // A stream registered with the scheduler. Its VadStream must only be read (timestamps)
+    // after drain(), or from its own speech callbacks.
+    class Stream {
+    private:
+        friend class VadScheduler;
+
+        VadStream vad;
+        size_t home;                 // Worker whose run queue receives this stream
+        std::mutex mutex;            // Guards inbox and queued
+        std::vector<float> inbox;    // Samples fed since the owning worker last picked them up
+        bool queued = false;         // In a run queue or being processed by a worker
+
+        Stream(const VadStream& Vad, size_t Home) : vad(Vad), home(Home) {}
+
+    public:
+        VadStream& stream() { return vad; }
+        const VadStream& stream() const { return vad; }
+    };
+
+private:
+    struct Worker {
+        std::mutex mutex;                    // Guards run_queue
+        std::deque<Stream*> run_queue;
+        std::unique_ptr<BatchedVadEngine> engine;
+        std::atomic<size_t> windows{ 0 };    // Windows processed by this worker
+        std::thread thread;
+    };
+
+    std::shared_ptr<VadModel> model;
+    size_t max_batch;
+    int sample_rate;
+    int windows_frame_size;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex streams_mutex;                // Guards streams
+    std::deque<std::unique_ptr<Stream>> streams;
+
+    std::mutex work_mutex;                   // Sleep/wake of idle workers
+    std::condition_variable work_cv;
+    std::atomic<size_t> runnable{ 0 };       // Streams sitting in run queues
+    bool stopping = false;
+
+    std::mutex idle_mutex;                   // drain() waits here
+    std::condition_variable idle_cv;
+    std::atomic<size_t> queued_streams{ 0 }; // Streams with queued == true
+
+    void enqueue(Stream* s, size_t w) {
+        runnable++;
+        {
+            std::lock_guard<std::mutex> lock(workers[w]->mutex);
+            workers[w]->run_queue.push_back(s);
+        }
+        {
+            std::lock_guard<std::mutex> lock(work_mutex);
+        }
+        work_cv.notify_one();
+    }
+
+    // Takes up to max_batch streams from worker w's queue, or steals from another worker.
+    void take_work(size_t w, std::vector<Stream*>& batch) {
+        {
+            std::lock_guard<std::mutex> lock(workers[w]->mutex);
+            std::deque<Stream*>& q = workers[w]->run_queue;
+            while (!q.empty() && batch.size() < max_batch) {
+                batch.push_back(q.front());
+                q.pop_front();
+            }
+        }
+        for (size_t i = 1; batch.empty() && i < workers.size(); i++) {
+            Worker& victim = *workers[(w + i) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            size_t n = std::min(max_batch, (victim.run_queue.size() + 1) / 2);
+            for (size_t k = 0; k < n; k++) {
+                batch.push_back(victim.run_queue.back());
+                victim.run_queue.pop_back();
+            }
+        }
+        runnable -= batch.size();
+    }
+
+    void worker_loop(size_t w) {
+        Worker& self = *workers[w];
+        std::vector<Stream*> batch;
+        std::vector<VadStream*> vads;
+        batch.reserve(max_batch);
+        vads.reserve(max_batch);
+        for (;;) {
+            batch.clear();
+            take_work(w, batch);
+            if (batch.empty()) {
+                std::unique_lock<std::mutex> lock(work_mutex);
+                if (stopping)
+                    return;
+                work_cv.wait(lock, [this] { return stopping || runnable > 0; });
+                continue;
+            }
+
+            // Move the pending audio of each stream into its VadStream; the worker now owns them.
+            vads.clear();
+            for (Stream* s : batch) {
+                std::lock_guard<std::mutex> lock(s->mutex);
+                s->vad.feed(s->inbox.data(), s->inbox.size());
+                s->inbox.clear();
+                vads.push_back(&s->vad);
+            }
+
+            self.windows += self.engine->run(vads.data(), vads.size());
+
+            // Release the streams; ones that received audio meanwhile go back to this worker's queue.
+            for (Stream* s : batch) {
+                bool requeue;
+                {
+                    std::lock_guard<std::mutex> lock(s->mutex);
+                    requeue = !s->inbox.empty();
+                    s->queued = requeue;
+                }
+                if (requeue) {
+                    enqueue(s, w);
+                }
+                else if (--queued_streams == 0) {
+                    std::lock_guard<std::mutex> lock(idle_mutex);
+                    idle_cv.notify_all();
+                }
+            }
+        }
+    }
+
+public:
+    // num_workers == 0 uses one worker per hardware thread.
+    VadScheduler(std::shared_ptr<VadModel> Model, size_t num_workers = 0, size_t Max_batch = 64,
+        int Sample_rate = 16000, int Windows_frame_size = 32)
+        : model(std::move(Model)), max_batch(Max_batch), sample_rate(Sample_rate),
+          windows_frame_size(Windows_frame_size)
+    {
+        if (num_workers == 0)
+            num_workers = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t w = 0; w < num_workers; w++) {
+            workers.emplace_back(new Worker());
+            workers[w]->engine.reset(new BatchedVadEngine(model, max_batch, sample_rate, windows_frame_size));
+        }
+        for (size_t w = 0; w < num_workers; w++)
+            workers[w]->thread = std::thread(&VadScheduler::worker_loop, this, w);
+    }
+
+    ~VadScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(work_mutex);
+            stopping = true;
+        }
+        work_cv.notify_all();
+        for (std::unique_ptr<Worker>& w : workers)
+            w->thread.join();
+    }
+
+    VadScheduler(const VadScheduler&) = delete;
+    VadScheduler& operator=(const VadScheduler&) = delete;
+
+    // Registers a stream; the returned pointer stays valid for the scheduler's lifetime.
+    // The parameters match VadIterator's segmentation parameters.
+    Stream* add_stream(float Threshold = 0.5, int min_silence_duration_ms = 100,
+        int speech_pad_ms = 30, int min_speech_duration_ms = 250,
+        float max_speech_duration_s = std::numeric_limits<float>::infinity()) {
+        std::lock_guard<std::mutex> lock(streams_mutex);
+        streams.emplace_back(new Stream(
+            VadStream(sample_rate, windows_frame_size, Threshold, min_silence_duration_ms,
+                speech_pad_ms, min_speech_duration_ms, max_speech_duration_s),
+            streams.size() % workers.size()));
+        return streams.back().get();
+    }
+
+    // Queues audio for a stream. Never blocks on inference.
+    void feed(Stream* s, const float* samples, size_t num_samples) {
+        bool schedule;
+        {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            s->inbox.insert(s->inbox.end(), samples, samples + num_samples);
+            schedule = !s->queued;
+            if (schedule) {
+                s->queued = true;
+                queued_streams++;
+            }
+        }
+        if (schedule)
+            enqueue(s, s->home);
+    }
+
+    // Blocks until every whole window fed so far has been processed.
+    void drain() {
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        idle_cv.wait(lock, [this] { return queued_streams == 0; });
+    }
+
+    size_t num_workers() const { return workers.size(); }
+
+    // Total windows processed by all workers since construction.
+    size_t windows_processed() const {
+        size_t total = 0;
+        for (const std::unique_ptr<Worker>& w : workers)
+            total += w->windows;
+        return total;
+    }
+};
+
+#endif  // SILERO_VAD_SCHEDULER_H_
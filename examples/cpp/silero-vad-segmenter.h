@@ -0,0 +1,237 @@
+#ifndef SILERO_VAD_SEGMENTER_H_
+#define SILERO_VAD_SEGMENTER_H_
+
+// Speech segment types and the segment state machine. Nothing here depends on an inference
+// runtime; the ONNX Runtime and native engines both drive VadSegmenter.
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <cstdio>
+#include <cstdarg>
+#include <functional>
+
+//#define __DEBUG_SPEECH_PROB___
+
+// timestamp_t class: stores the start and end (in samples) of a speech segment.
+// 64-bit, since a 32-bit sample count overflows after about 37 hours at 16 kHz.
+class timestamp_t {
+public:
+    int64_t start;
+    int64_t end;
+
+    timestamp_t(int64_t start = -1, int64_t end = -1)
+        : start(start), end(end) { }
+
+    bool operator==(const timestamp_t& a) const {
+        return (start == a.start && end == a.end);
+    }
+
+    // Returns a formatted string of the timestamp.
+    std::string c_str() const {
+        return format("{start:%08lld, end:%08lld}", static_cast<long long>(start), static_cast<long long>(end));
+    }
+private:
+    // Helper function for formatting.
+    std::string format(const char* fmt, ...) const {
+        char buf[256];
+        va_list args;
+        va_start(args, fmt);
+        const auto r = std::vsnprintf(buf, sizeof(buf), fmt, args);
+        va_end(args);
+        if (r < 0)
+            return {};
+        const size_t len = r;
+        if (len < sizeof(buf))
+            return std::string(buf, len);
+#if __cplusplus >= 201703L
+        std::string s(len, '\0');
+        va_start(args, fmt);
+        std::vsnprintf(s.data(), len + 1, fmt, args);
+        va_end(args);
+        return s;
+#else
+        auto vbuf = std::unique_ptr<char[]>(new char[len + 1]);
+        va_start(args, fmt);
+        std::vsnprintf(vbuf.get(), len + 1, fmt, args);
+        va_end(args);
+        return std::string(vbuf.get(), len);
+#endif
+    }
+};
+
+// VadSegmenter class: turns per-window speech probabilities into speech segments.
+// It holds no model state, so it can be driven by any inference engine.
+class VadSegmenter {
+private:
+    // Configuration parameters
+    int sample_rate;
+    int window_size_samples;
+    float threshold;
+    int min_silence_samples;
+    int min_silence_samples_at_max_speech;
+    int min_speech_samples;
+    float max_speech_samples;
+    int speech_pad_samples;
+
+    // State management
+    bool triggered = false;
+    int64_t temp_end = 0;
+    int64_t current_sample = 0;
+    int64_t prev_end = 0;
+    int64_t next_start = 0;
+    std::vector<timestamp_t> speeches;
+    timestamp_t current_speech;
+
+    // Live segment listeners
+    std::function<void(int64_t)> on_speech_start;            // Called with the start sample of a new segment.
+    std::function<void(const timestamp_t&)> on_speech_end;   // Called with each finished segment.
+
+    // Starts a speech segment at start_sample and notifies the listener.
+    void start_speech(int64_t start_sample) {
+        current_speech.start = start_sample;
+        if (on_speech_start)
+            on_speech_start(start_sample);
+    }
+
+    // Stores the finished current_speech and notifies the listener.
+    void push_speech() {
+        speeches.push_back(current_speech);
+        if (on_speech_end)
+            on_speech_end(current_speech);
+    }
+
+public:
+    // The parameters are set to match the Python version.
+    VadSegmenter(int Sample_rate = 16000, int Window_size_samples = 512,
+        float Threshold = 0.5, int min_silence_duration_ms = 100,
+        int speech_pad_ms = 30, int min_speech_duration_ms = 250,
+        float max_speech_duration_s = std::numeric_limits<float>::infinity())
+        : sample_rate(Sample_rate), window_size_samples(Window_size_samples), threshold(Threshold),
+          speech_pad_samples(speech_pad_ms)
+    {
+        int sr_per_ms = sample_rate / 1000;
+        min_speech_samples = sr_per_ms * min_speech_duration_ms;
+        max_speech_samples = (sample_rate * max_speech_duration_s - window_size_samples - 2 * speech_pad_samples);
+        min_silence_samples = sr_per_ms * min_silence_duration_ms;
+        min_silence_samples_at_max_speech = sr_per_ms * 98;
+    }
+
+    // Resets the segment state and drops collected timestamps (listeners are kept).
+    void reset() {
+        triggered = false;
+        temp_end = 0;
+        current_sample = 0;
+        prev_end = next_start = 0;
+        speeches.clear();
+        current_speech = timestamp_t();
+    }
+
+    // Advances by one window with the model's speech probability for it.
+    void push(float speech_prob) {
+        current_sample += window_size_samples; // Advance by the original window size.
+
+        // If speech is detected (probability >= threshold)
+        if (speech_prob >= threshold) {
+#ifdef __DEBUG_SPEECH_PROB___
+            float speech = current_sample - window_size_samples;
+            printf("{ start: %.3f s (%.3f) %08lld}\n", 1.0f * speech / sample_rate, speech_prob, static_cast<long long>(current_sample - window_size_samples));
+#endif
+            if (temp_end != 0) {
+                temp_end = 0;
+                if (next_start < prev_end)
+                    next_start = current_sample - window_size_samples;
+            }
+            if (!triggered) {
+                triggered = true;
+                start_speech(current_sample - window_size_samples);
+            }
+            return;
+        }
+
+        // If the speech segment becomes too long.
+        if (triggered && ((current_sample - current_speech.start) > max_speech_samples)) {
+            if (prev_end > 0) {
+                current_speech.end = prev_end;
+                push_speech();
+                current_speech = timestamp_t();
+                if (next_start < prev_end)
+                    triggered = false;
+                else
+                    start_speech(next_start);
+                prev_end = 0;
+                next_start = 0;
+                temp_end = 0;
+            }
+            else {
+                current_speech.end = current_sample;
+                push_speech();
+                current_speech = timestamp_t();
+                prev_end = 0;
+                next_start = 0;
+                temp_end = 0;
+                triggered = false;
+            }
+            return;
+        }
+
+        if ((speech_prob >= (threshold - 0.15)) && (speech_prob < threshold)) {
+            // When the speech probability temporarily drops but is still in speech, keep the current state.
+            return;
+        }
+
+        if (speech_prob < (threshold - 0.15)) {
+#ifdef __DEBUG_SPEECH_PROB___
+            float speech = current_sample - window_size_samples - speech_pad_samples;
+            printf("{ end: %.3f s (%.3f) %08lld}\n", 1.0f * speech / sample_rate, speech_prob, static_cast<long long>(current_sample - window_size_samples));
+#endif
+            if (triggered) {
+                if (temp_end == 0)
+                    temp_end = current_sample;
+                if (current_sample - temp_end > min_silence_samples_at_max_speech)
+                    prev_end = temp_end;
+                if ((current_sample - temp_end) >= min_silence_samples) {
+                    current_speech.end = temp_end;
+                    if (current_speech.end - current_speech.start > min_speech_samples) {
+                        push_speech();
+                        current_speech = timestamp_t();
+                        prev_end = 0;
+                        next_start = 0;
+                        temp_end = 0;
+                        triggered = false;
+                    }
+                }
+            }
+            return;
+        }
+    }
+
+    // Ends the stream: closes an open speech segment at audio_length_samples.
+    void flush(int64_t audio_length_samples) {
+        if (current_speech.start >= 0) {
+            current_speech.end = audio_length_samples;
+            push_speech();
+            current_speech = timestamp_t();
+            prev_end = 0;
+            next_start = 0;
+            temp_end = 0;
+            triggered = false;
+        }
+    }
+
+    // Registers listeners for live segment events (either may be empty).
+    void set_speech_callbacks(std::function<void(int64_t)> on_start,
+        std::function<void(const timestamp_t&)> on_end) {
+        on_speech_start = std::move(on_start);
+        on_speech_end = std::move(on_end);
+    }
+
+    // Returns the speech segments finished so far (in samples).
+    const std::vector<timestamp_t>& get_speech_timestamps() const {
+        return speeches;
+    }
+};
+
+#endif  // SILERO_VAD_SEGMENTER_H_
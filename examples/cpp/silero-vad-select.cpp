@@ -0,0 +1,105 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Startup backend selection (select_vad_backend) and the shared Vad interface.
+//
+// It runs the calibration over the default candidates (native engine, ONNX Runtime at
+// several thread counts, LibTorch when built with -DSILERO_VAD_LIBTORCH) and reports each
+// candidate's median time per window and the selected backend. It then runs every usable
+// backend through Vad on the same audio:
+//   rtf               : processing time / audio duration
+//   segments          : segment count (all backends share one segmenter)
+//   segments_exact    : segments identical to the selected backend's
+//
+// The audio is synthetic unless --wav (16 kHz) is given. Output is JSON.
+//
+// Usage: ./select [--model silero_vad.onnx] [--jit silero_vad.jit] [--wav file.wav]
+//                 [--seconds 60] [--calibration-windows 200]
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "silero-vad-engine.h"
+#include "silero-vad-testaudio.h"
+#include "wav.h"
+
+int main(int argc, char* argv[]) {
+    std::string model_path = "../../src/silero_vad/data/silero_vad.onnx";
+    std::string jit_path;
+    std::string wav_path;
+    double seconds = 60.0;
+    int calibration_windows = 200;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--model") model_path = argv[i + 1];
+        else if (key == "--jit") jit_path = argv[i + 1];
+        else if (key == "--wav") wav_path = argv[i + 1];
+        else if (key == "--seconds") seconds = std::stod(argv[i + 1]);
+        else if (key == "--calibration-windows") calibration_windows = std::stoi(argv[i + 1]);
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    const int sample_rate = 16000;
+
+    std::vector<float> audio;
+    if (wav_path.empty()) {
+        audio = make_test_audio(sample_rate, seconds, 17);
+    } else {
+        wav::WavStreamReader reader(wav_path);
+        if (reader.sample_rate() != sample_rate) {
+            fprintf(stderr, "%s: expected %d Hz audio\n", wav_path.c_str(), sample_rate);
+            return 1;
+        }
+        std::vector<float> block(sample_rate);
+        for (size_t n; (n = reader.Read(block.data(), block.size())) > 0; )
+            audio.insert(audio.end(), block.begin(), block.begin() + n);
+    }
+
+    std::vector<std::shared_ptr<const VadBackend>> candidates = default_vad_backends(model_path, jit_path);
+    std::vector<VadCalibration> calibration;
+    std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+    std::shared_ptr<const VadBackend> selected = select_vad_backend(candidates, sample_rate,
+        calibration_windows, &calibration);
+    double calibration_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t).count();
+
+    printf("{\n  \"calibration_ms\": %.1f,\n  \"selected\": \"%s\",\n  \"candidates\": [\n",
+        calibration_ms, selected->name().c_str());
+    for (size_t i = 0; i < calibration.size(); i++) {
+        if (calibration[i].us_per_window < std::numeric_limits<double>::infinity())
+            printf("    {\"name\": \"%s\", \"us_per_window\": %.2f}", calibration[i].name.c_str(),
+                calibration[i].us_per_window);
+        else
+            printf("    {\"name\": \"%s\", \"us_per_window\": null}", calibration[i].name.c_str());
+        printf("%s\n", i + 1 == calibration.size() ? "" : ",");
+    }
+
+    Vad reference(selected, sample_rate);
+    reference.process(audio);
+    const std::vector<timestamp_t>& ref = reference.get_speech_timestamps();
+
+    printf("  ],\n  \"audio_seconds\": %.1f,\n  \"runs\": [\n", static_cast<double>(audio.size()) / sample_rate);
+    bool first = true;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (!(calibration[i].us_per_window < std::numeric_limits<double>::infinity()))
+            continue;
+        Vad vad(candidates[i], sample_rate);
+        t = std::chrono::steady_clock::now();
+        vad.process(audio);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count();
+        const std::vector<timestamp_t>& segments = vad.get_speech_timestamps();
+        size_t exact = 0;
+        for (const timestamp_t& s : segments)
+            exact += std::find(ref.begin(), ref.end(), s) != ref.end();
+        printf("%s    {\"name\": \"%s\", \"rtf\": %.6f, \"segments\": %zu, \"segments_exact\": %zu}",
+            first ? "" : ",\n", candidates[i]->name().c_str(), elapsed * sample_rate / audio.size(),
+            segments.size(), exact);
+        first = false;
+    }
+    printf("\n  ]\n}\n");
+    return 0;
+}
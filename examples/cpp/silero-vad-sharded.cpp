@@ -0,0 +1,168 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// Time-parallel processing of one long recording (ShardedVad) against the sequential
+// VadIterator result on the same audio.
+//
+// For 1, 2, 4, ... up to --threads shards (with --warmup seconds of overlap), and for a
+// range of warm-ups at the full shard count, it reports:
+//   ms / speedup        : wall time and speedup over the sequential run
+//   prob_max_err / mae  : per-window probability difference from the sequential run
+//   label_agreement     : share of windows with the same speech/non-speech label
+//                         (from the final segments)
+//   segments / segments_exact: segment count, and how many sequential segments are
+//                         reproduced with identical start and end
+//
+// The audio is synthetic unless --wav (16 kHz) is given. Output is JSON.
+//
+// Usage: ./sharded [--model silero_vad.onnx] [--wav file.wav] [--seconds 600]
+//                  [--threads N] [--warmup 2.0]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-sharded.h"
+#include "silero-vad-testaudio.h"
+#include "wav.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double seconds_since(Clock::time_point begin) {
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+// Per-window speech labels from segments.
+std::vector<bool> window_labels(const std::vector<timestamp_t>& segments, size_t num_windows, int window) {
+    std::vector<bool> labels(num_windows, false);
+    for (const timestamp_t& seg : segments) {
+        size_t first = static_cast<size_t>(std::max<int64_t>(0, seg.start)) / window;
+        size_t last = static_cast<size_t>(std::max<int64_t>(0, seg.end)) / window;
+        for (size_t w = first; w < std::min(last, num_windows); w++)
+            labels[w] = true;
+    }
+    return labels;
+}
+
+struct Reference {
+    std::vector<float> probs;
+    std::vector<timestamp_t> segments;
+    std::vector<bool> labels;
+    double seconds;
+};
+
+void print_run(const Reference& ref, const ShardedVad& vad, int shards, double warmup_seconds, double seconds,
+    bool last) {
+    const std::vector<float>& probs = vad.speech_probs();
+    const std::vector<timestamp_t>& segments = vad.get_speech_timestamps();
+    double max_err = 0.0, sum_err = 0.0;
+    for (size_t w = 0; w < probs.size(); w++) {
+        double err = std::fabs(static_cast<double>(probs[w]) - ref.probs[w]);
+        max_err = std::max(max_err, err);
+        sum_err += err;
+    }
+    std::vector<bool> labels = window_labels(segments, probs.size(), vad.window_samples());
+    size_t agree = 0;
+    for (size_t w = 0; w < labels.size(); w++)
+        agree += labels[w] == ref.labels[w];
+    size_t exact = 0;
+    for (const timestamp_t& s : ref.segments)
+        for (const timestamp_t& t : segments)
+            if (s.start == t.start && s.end == t.end) {
+                exact++;
+                break;
+            }
+    printf("    {\"shards\": %d, \"warmup_seconds\": %.2f, \"ms\": %.1f, \"speedup\": %.2f, \"prob_max_err\": %.6f, "
+        "\"prob_mae\": %.2e, \"label_agreement\": %.6f, \"segments\": %zu, \"segments_exact\": %zu}%s\n",
+        shards, warmup_seconds, seconds * 1e3, ref.seconds / seconds, max_err, sum_err / std::max<size_t>(1, probs.size()),
+        static_cast<double>(agree) / std::max<size_t>(1, labels.size()), segments.size(), exact, last ? "" : ",");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string model_arg = "../../src/silero_vad/data/silero_vad.onnx";
+    std::string wav_path;
+    double seconds = 600.0;
+    double warmup_seconds = 2.0;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key == "--model") model_arg = argv[i + 1];
+        else if (key == "--wav") wav_path = argv[i + 1];
+        else if (key == "--seconds") seconds = std::stod(argv[i + 1]);
+        else if (key == "--threads") threads = std::max(1, std::stoi(argv[i + 1]));
+        else if (key == "--warmup") warmup_seconds = std::stod(argv[i + 1]);
+        else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    const int sample_rate = 16000;
+    const int window = 512;
+
+    std::vector<float> audio;
+    if (wav_path.empty()) {
+        audio = make_test_audio(sample_rate, seconds, 11);
+    } else {
+        wav::WavStreamReader reader(wav_path);
+        if (reader.sample_rate() != sample_rate) {
+            fprintf(stderr, "%s: expected %d Hz audio\n", wav_path.c_str(), sample_rate);
+            return 1;
+        }
+        std::vector<float> block(sample_rate);
+        for (size_t n; (n = reader.Read(block.data(), block.size())) > 0; )
+            audio.insert(audio.end(), block.begin(), block.begin() + n);
+    }
+    std::shared_ptr<VadModel> model = VadModel::get(std::basic_string<ORTCHAR_T>(model_arg.begin(), model_arg.end()));
+
+    // Sequential reference
+    Reference ref;
+    {
+        VadIterator vad(model, sample_rate);
+        ref.probs.reserve(audio.size() / window);
+        Clock::time_point t = Clock::now();
+        for (size_t i = 0; i + window <= audio.size(); i += window) {
+            vad.feed(audio.data() + i, window);
+            ref.probs.push_back(vad.last_speech_prob());
+        }
+        vad.feed(audio.data() + ref.probs.size() * window, audio.size() - ref.probs.size() * window);
+        vad.flush();
+        ref.seconds = seconds_since(t);
+        ref.segments = vad.get_speech_timestamps();
+        ref.labels = window_labels(ref.segments, ref.probs.size(), window);
+    }
+
+    const int warmup_windows = static_cast<int>(warmup_seconds * sample_rate / window + 0.5);
+    std::vector<int> shard_counts;
+    for (int k = 1; k < threads; k *= 2)
+        shard_counts.push_back(k);
+    shard_counts.push_back(threads);
+    const double warmups[] = { 0.0, 0.25, 0.5, 1.0, 2.0, 4.0 };
+
+    printf("{\n  \"audio_seconds\": %.1f,\n  \"sequential_ms\": %.1f,\n  \"sequential_segments\": %zu,\n",
+        static_cast<double>(audio.size()) / sample_rate, ref.seconds * 1e3, ref.segments.size());
+    printf("  \"scaling\": [\n");
+    ShardedVad vad(model, sample_rate);
+    for (size_t i = 0; i < shard_counts.size(); i++) {
+        Clock::time_point t = Clock::now();
+        vad.process(audio, shard_counts[i], warmup_windows);
+        print_run(ref, vad, shard_counts[i], warmup_seconds, seconds_since(t), i + 1 == shard_counts.size());
+    }
+    printf("  ],\n  \"warmup\": [\n");
+    for (size_t i = 0; i < sizeof(warmups) / sizeof(warmups[0]); i++) {
+        Clock::time_point t = Clock::now();
+        vad.process(audio, threads, static_cast<int>(warmups[i] * sample_rate / window + 0.5));
+        print_run(ref, vad, threads, warmups[i], seconds_since(t), i + 1 == sizeof(warmups) / sizeof(warmups[0]));
+    }
+    printf("  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+#ifndef SILERO_VAD_SHARDED_H_
+#define SILERO_VAD_SHARDED_H_
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "silero-vad-onnx.h"
+#include "silero-vad-segmenter.h"
+
+// ShardedVad class: time-parallel processing of one long recording.
+//
+// The audio is cut at window boundaries into num_shards contiguous shards, processed on
+// separate threads that share one VadModel. Every shard except the first starts
+// warmup_windows windows early from a zero LSTM state. The warm-up probabilities are
+// discarded; they only let the state converge to what sequential processing would have at
+// the shard boundary. The warm-up also supplies the context samples of the shard's first
+// window.
+//
+// The shard probabilities are then concatenated in order and run through one VadSegmenter,
+// so segments never break at shard boundaries. The result depends only on the audio,
+// num_shards and warmup_windows, not on thread timing. With one shard, or a warm-up that
+// reaches back to the start of the file, it is identical to VadIterator::process().
+class ShardedVad {
+private:
+    std::shared_ptr<VadModel> model;
+    int sample_rate;
+    int windows_frame_size;
+    int window_size_samples;
+    VadSegmenter segmenter;
+    std::vector<float> probs;
+
+    // Windows [first, end) of the audio, after warm-up from window `warmup_from`.
+    void run_shard(const float* audio, size_t first, size_t end, size_t warmup_from) {
+        VadIterator vad(model, sample_rate, windows_frame_size);
+        const size_t window = static_cast<size_t>(window_size_samples);
+        for (size_t w = warmup_from; w < first; w++)
+            vad.feed(audio + w * window, window);
+        for (size_t w = first; w < end; w++) {
+            vad.feed(audio + w * window, window);
+            probs[w] = vad.last_speech_prob();
+        }
+    }
+
+public:
+    // The parameters after Model match VadIterator.
+    ShardedVad(std::shared_ptr<VadModel> Model,
+        int Sample_rate = 16000, int Windows_frame_size = 32,
+        float Threshold = 0.5, int min_silence_duration_ms = 100,
+        int speech_pad_ms = 30, int min_speech_duration_ms = 250,
+        float max_speech_duration_s = std::numeric_limits<float>::infinity())
+        : model(std::move(Model)), sample_rate(Sample_rate), windows_frame_size(Windows_frame_size)
+    {
+        model->check_sample_rate(sample_rate);
+        window_size_samples = windows_frame_size * (sample_rate / 1000);
+        segmenter = VadSegmenter(sample_rate, window_size_samples, Threshold, min_silence_duration_ms,
+            speech_pad_ms, min_speech_duration_ms, max_speech_duration_s);
+    }
+
+    // Processes the whole recording on num_shards threads (0: one per hardware thread).
+    // warmup_windows is the overlap each shard runs before its first kept window; a few
+    // seconds of audio (e.g. 64 windows = 2 s at 16 kHz) are usually enough.
+    void process(const float* audio, size_t num_samples, int num_shards = 0, int warmup_windows = 64) {
+        if (num_shards <= 0)
+            num_shards = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        if (warmup_windows < 0)
+            throw std::invalid_argument("ShardedVad: warmup_windows must not be negative");
+        const size_t num_windows = num_samples / window_size_samples;
+        const size_t shards = std::max<size_t>(1, std::min<size_t>(num_shards, num_windows));
+        probs.assign(num_windows, 0.0f);
+
+        std::vector<std::thread> threads;
+        for (size_t k = 1; k < shards; k++) {
+            size_t first = num_windows * k / shards;
+            size_t end = num_windows * (k + 1) / shards;
+            size_t warmup_from = first > static_cast<size_t>(warmup_windows) ? first - warmup_windows : 0;
+            threads.emplace_back(&ShardedVad::run_shard, this, audio, first, end, warmup_from);
+        }
+        run_shard(audio, 0, num_windows / shards, 0);  // first shard on the calling thread
+        for (std::thread& t : threads)
+            t.join();
+
+        segmenter.reset();
+        for (float p : probs)
+            segmenter.push(p);
+        segmenter.flush(static_cast<int>(num_samples));
+    }
+
+    void process(const std::vector<float>& audio, int num_shards = 0, int warmup_windows = 64) {
+        process(audio.data(), audio.size(), num_shards, warmup_windows);
+    }
+
+    // Per-window speech probabilities of the last process() call.
+    const std::vector<float>& speech_probs() const {
+        return probs;
+    }
+
+    // Speech timestamps of the last process() call, in samples.
+    const std::vector<timestamp_t>& get_speech_timestamps() const {
+        return segmenter.get_speech_timestamps();
+    }
+
+    int window_samples() const {
+        return window_size_samples;
+    }
+};
+
+#endif  // SILERO_VAD_SHARDED_H_
@@ -0,0 +1,170 @@
+#ifndef SILERO_VAD_STATS_H_
+#define SILERO_VAD_STATS_H_
+
+// Optional per-stage timing for the VadIterator hot path.
+//
+// Build with -DSILERO_VAD_STATS to enable it. VadIterator then times every window stage by
+// stage and exposes the results through stats() / reset_stats(). Without the define,
+// neither the hooks nor the stats member are compiled in, so there is no cost at all.
+//
+// Each stage takes one steady_clock read (about 20 ns) per window. That is well under 1% of
+// a ~50-100 us window.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// SILERO_VAD_STATS_DO(statements) keeps the statements only in instrumented builds.
+#ifdef SILERO_VAD_STATS
+#define SILERO_VAD_STATS_DO(...) __VA_ARGS__
+#else
+#define SILERO_VAD_STATS_DO(...)
+#endif
+
+// Stages of one window, in the order they run.
+enum VadStage {
+    VAD_STAGE_INPUT = 0,   // copying/converting samples into the model input buffer
+    VAD_STAGE_RUN,         // session->Run
+    VAD_STAGE_STATE,       // stateN -> state copy and context shift
+    VAD_STAGE_SEGMENTER,   // speech/silence state machine
+    VAD_STAGE_WINDOW,      // the whole window (sum of the above)
+    VAD_STAGE_COUNT
+};
+
+inline const char* vad_stage_name(int stage) {
+    static const char* const names[VAD_STAGE_COUNT] = { "input", "run", "state", "segmenter", "window" };
+    return stage >= 0 && stage < VAD_STAGE_COUNT ? names[stage] : "?";
+}
+
+// Nanoseconds from a monotonic clock.
+inline uint64_t vad_stats_now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// LatencyHistogram class: log-linear histogram of nanosecond durations.
+// Each power of two is split into 8 linear sub-buckets, so any recorded value is off by at
+// most 12.5%. record() is a few integer ops and no allocation. Values up to ~18 minutes
+// are resolved; larger ones land in the last bucket.
+class LatencyHistogram {
+public:
+    static const int kSubBits = 3;
+    static const int kSub = 1 << kSubBits;
+    static const int kMaxExp = 40;
+    static const int kBuckets = kSub + (kMaxExp - kSubBits + 1) * kSub;
+
+    LatencyHistogram() { reset(); }
+
+    void reset() {
+        std::memset(buckets, 0, sizeof(buckets));
+        count_ = 0;
+        total_ = 0;
+        min_ = UINT64_MAX;
+        max_ = 0;
+    }
+
+    void record(uint64_t ns) {
+        buckets[bucket_of(ns)]++;
+        count_++;
+        total_ += ns;
+        if (ns < min_) min_ = ns;
+        if (ns > max_) max_ = ns;
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t total_ns() const { return total_; }
+    uint64_t min_ns() const { return count_ ? min_ : 0; }
+    uint64_t max_ns() const { return max_; }
+    double mean_ns() const { return count_ ? static_cast<double>(total_) / count_ : 0.0; }
+
+    // Value at quantile q in [0, 1], taken as the middle of its bucket.
+    double percentile_ns(double q) const {
+        if (count_ == 0)
+            return 0.0;
+        uint64_t rank = static_cast<uint64_t>(q * (count_ - 1)) + 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; i++) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                if (i == kBuckets - 1)
+                    return static_cast<double>(max_);
+                double mid = 0.5 * (static_cast<double>(bucket_low(i)) + static_cast<double>(bucket_low(i + 1) - 1));
+                if (mid < min_) mid = static_cast<double>(min_);
+                if (mid > max_) mid = static_cast<double>(max_);
+                return mid;
+            }
+        }
+        return static_cast<double>(max_);
+    }
+
+    // Adds another histogram's samples to this one.
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < kBuckets; i++)
+            buckets[i] += other.buckets[i];
+        count_ += other.count_;
+        total_ += other.total_;
+        if (other.min_ < min_) min_ = other.min_;
+        if (other.max_ > max_) max_ = other.max_;
+    }
+
+private:
+    uint32_t buckets[kBuckets];
+    uint64_t count_, total_, min_, max_;
+
+    static int highest_bit(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(v);
+#else
+        int b = 0;
+        while (v >>= 1)
+            b++;
+        return b;
+#endif
+    }
+
+    static int bucket_of(uint64_t v) {
+        if (v < static_cast<uint64_t>(kSub))
+            return static_cast<int>(v);
+        int e = highest_bit(v);
+        if (e > kMaxExp)
+            return kBuckets - 1;
+        int sub = static_cast<int>(v >> (e - kSubBits)) - kSub;
+        return kSub + (e - kSubBits) * kSub + sub;
+    }
+
+    // Smallest value that falls in bucket i.
+    static uint64_t bucket_low(int i) {
+        if (i < kSub)
+            return static_cast<uint64_t>(i);
+        int e = (i - kSub) / kSub + kSubBits;
+        int sub = (i - kSub) % kSub;
+        return static_cast<uint64_t>(kSub + sub) << (e - kSubBits);
+    }
+};
+
+// VadStats class: one histogram per stage, plus a summary printer.
+class VadStats {
+public:
+    LatencyHistogram stage[VAD_STAGE_COUNT];
+
+    const LatencyHistogram& operator[](VadStage s) const { return stage[s]; }
+
+    void reset() {
+        for (int i = 0; i < VAD_STAGE_COUNT; i++)
+            stage[i].reset();
+    }
+
+    // Prints count, mean, p50, p99 and max per stage, in microseconds.
+    void print(FILE* out = stdout) const {
+        fprintf(out, "%-10s %10s %10s %10s %10s %10s\n", "stage", "count", "mean_us", "p50_us", "p99_us", "max_us");
+        for (int i = 0; i < VAD_STAGE_COUNT; i++) {
+            const LatencyHistogram& h = stage[i];
+            fprintf(out, "%-10s %10llu %10.2f %10.2f %10.2f %10.2f\n", vad_stage_name(i),
+                static_cast<unsigned long long>(h.count()), h.mean_ns() / 1e3,
+                h.percentile_ns(0.50) / 1e3, h.percentile_ns(0.99) / 1e3, h.max_ns() / 1e3);
+        }
+    }
+};
+
+#endif  // SILERO_VAD_STATS_H_
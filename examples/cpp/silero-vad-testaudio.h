@@ -0,0 +1,43 @@
+#ifndef SILERO_VAD_TESTAUDIO_H_
+#define SILERO_VAD_TESTAUDIO_H_
+
+// Deterministic synthetic audio for the benchmarks and accuracy reports, so they need no
+// recordings.
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Synthetic test audio: voiced bursts (harmonic series with a drifting pitch and a
+// syllable-rate envelope) separated by pauses of silence or low noise.
+inline std::vector<float> make_test_audio(int sample_rate, double seconds, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> uni(0.0f, 1.0f);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<float> audio(static_cast<size_t>(sample_rate * seconds));
+    const double two_pi = 6.283185307179586;
+    size_t i = 0;
+    while (i < audio.size()) {
+        // Speech-like burst of 0.5..3 s
+        size_t burst = static_cast<size_t>(sample_rate * (0.5 + 2.5 * uni(rng)));
+        double f0 = 100.0 + 150.0 * uni(rng), phase = 0.0;
+        for (size_t k = 0; k < burst && i < audio.size(); k++, i++) {
+            double t = static_cast<double>(k) / sample_rate;
+            double pitch = f0 * (1.0 + 0.1 * std::sin(two_pi * 0.7 * t));
+            phase += two_pi * pitch / sample_rate;
+            double env = 0.5 - 0.5 * std::cos(two_pi * 4.0 * t);  // ~4 syllables/s
+            double v = 0.0;
+            for (int h = 1; h <= 8; h++)
+                v += std::sin(h * phase) / h;
+            audio[i] = static_cast<float>(0.25 * env * v) + 0.005f * noise(rng);
+        }
+        // Pause of 0.3..2 s: digital silence or background noise
+        size_t pause = static_cast<size_t>(sample_rate * (0.3 + 1.7 * uni(rng)));
+        float level = uni(rng) < 0.5f ? 0.0f : 0.01f;
+        for (size_t k = 0; k < pause && i < audio.size(); k++, i++)
+            audio[i] = level * noise(rng);
+    }
+    return audio;
+}
+
+#endif  // SILERO_VAD_TESTAUDIO_H_
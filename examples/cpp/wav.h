@@ -22,10 +22,26 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include <iostream>
 
+#include "pcm_convert.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 // #include "utils/log.h"
 
 namespace wav {
@@ -48,7 +64,7 @@ struct WavHeader {
 
 class WavReader {
  public:
-  WavReader() : data_(nullptr) {}
+  WavReader() {}
   explicit WavReader(const std::string& filename) { Open(filename); }
 
   bool Open(const std::string& filename) {
@@ -65,10 +81,21 @@ class WavReader {
               "to have fmt chunk of at least size 16.\n");
       return false;
     } else if (header.fmt_size > 16) {
+      // WAVE_FORMAT_EXTENSIBLE: the real format tag starts the subformat GUID,
+      // 24 bytes into the fmt chunk.
+      if (header.format == 0xFFFE && header.fmt_size >= 40) {
+        fseek(fp, 20 + 24, SEEK_SET);
+        fread(&header.format, 1, sizeof(header.format), fp);
+      }
       int offset = 44 - 8 + header.fmt_size - 16;
       fseek(fp, offset, SEEK_SET);
       fread(header.data, 8, sizeof(char), fp);
     }
+    if (header.format != 1 && header.format != 3) {
+      printf("WaveData: unsupported format tag 0x%04x.\n", header.format);
+      fclose(fp);
+      return false;
+    }
     // check "riff" "WAVE" "fmt " "data"
 
     // Skip any sub-chunks between "fmt" and "data".  Usually there will
@@ -101,50 +128,24 @@ class WavReader {
     std::cout << "num_samples     :" << num_data << std::endl;
     std::cout << "num_data_size   :" << header.data_size << std::endl;
 
-    switch (bits_per_sample_) {
-        case 8: {
-            char sample;
-            for (int i = 0; i < num_data; ++i) {
-                fread(&sample, 1, sizeof(char), fp);
-                data_[i] = static_cast<float>(sample) / 32768;
-            }
-            break;
-        }
-        case 16: {
-            int16_t sample;
-            for (int i = 0; i < num_data; ++i) {
-                fread(&sample, 1, sizeof(int16_t), fp);
-                data_[i] = static_cast<float>(sample) / 32768;
-            }
-            break;
-        }
-        case 32:
-        {
-            if (header.format == 1) //S32
-            {
-                int sample;
-                for (int i = 0; i < num_data; ++i) {
-                    fread(&sample, 1, sizeof(int), fp);
-                    data_[i] = static_cast<float>(sample) / 32768;
-                }
-            }
-            else if (header.format == 3) // IEEE-float
-            {
-                float sample;
-                for (int i = 0; i < num_data; ++i) {
-                    fread(&sample, 1, sizeof(float), fp);
-                    data_[i] = static_cast<float>(sample);
-                }
-            }
-            else {
-                printf("unsupported quantization bits\n");
-            }
-            break;
-        }
-        default:
-            printf("unsupported quantization bits\n");
-            break;
+    // Read the payload in blocks and convert each block with the SIMD kernels
+    // (pcm_convert.h) instead of one fread per sample.
+    const int bytes_per_sample = bits_per_sample_ / 8;
+    const int kBlockSamples = 16384;
+    std::vector<char> block(static_cast<size_t>(kBlockSamples) * bytes_per_sample);
+    int done = 0;
+    while (done < num_data) {
+      int n = std::min(kBlockSamples, num_data - done);
+      int got = static_cast<int>(fread(block.data(), bytes_per_sample, n, fp));
+      if (!pcm::ToFloat(header.format, bits_per_sample_, block.data(),
+                        data_ + done, got)) {
+        printf("unsupported quantization bits\n");
+        break;
+      }
+      done += got;
+      if (got < n) break;
     }
+    for (; done < num_data; ++done) data_[done] = 0.0f;  // truncated file
 
     fclose(fp);
     return true;
@@ -162,11 +163,418 @@ class WavReader {
   const float* data() const { return data_; }
 
  private:
-  int num_channel_;
-  int sample_rate_;
-  int bits_per_sample_;
-  int num_samples_;  // sample points per channel
-  float* data_;
+  // Zero (no data) until Open() succeeds.
+  int num_channel_ = 0;
+  int sample_rate_ = 0;
+  int bits_per_sample_ = 0;
+  int num_samples_ = 0;  // sample points per channel
+  float* data_ = nullptr;
+};
+
+// Sample encodings of the PCM payload understood by MmapWavReader.
+enum class PcmFormat { kUnknown, kUInt8, kInt16, kInt24, kInt32, kFloat32 };
+
+// Maps a fmt chunk format tag (1 = integer PCM, 3 = IEEE float) and bit depth to a PcmFormat.
+inline PcmFormat PcmFormatOf(int format_tag, int bits) {
+  if (format_tag == 1 && bits == 8) return PcmFormat::kUInt8;
+  if (format_tag == 1 && bits == 16) return PcmFormat::kInt16;
+  if (format_tag == 1 && bits == 24) return PcmFormat::kInt24;
+  if (format_tag == 1 && bits == 32) return PcmFormat::kInt32;
+  if (format_tag == 3 && bits == 32) return PcmFormat::kFloat32;
+  return PcmFormat::kUnknown;
+}
+
+// Memory-mapped WAV reader. Unlike WavReader, nothing is read or decoded up
+// front: the RIFF chunks are parsed in place, the PCM payload is exposed as a
+// zero-copy view into the mapping, and samples are converted to float only when
+// ReadFloat() is called, e.g. window by window straight into a model input.
+class MmapWavReader {
+ public:
+  MmapWavReader() {}
+  explicit MmapWavReader(const std::string& filename) { Open(filename); }
+  ~MmapWavReader() { Close(); }
+
+  MmapWavReader(const MmapWavReader&) = delete;
+  MmapWavReader& operator=(const MmapWavReader&) = delete;
+
+  bool Open(const std::string& filename) {
+    Close();
+#ifdef _WIN32
+    file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file_ == INVALID_HANDLE_VALUE) {
+      fprintf(stderr, "Error in read %s\n", filename.c_str());
+      return false;
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(file_, &size);
+    size_ = static_cast<size_t>(size.QuadPart);
+    mapping_ = size_ > 0 ? CreateFileMappingA(file_, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    base_ = mapping_ ? static_cast<const uint8_t*>(
+                           MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0))
+                     : nullptr;
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      fprintf(stderr, "Error in read %s\n", filename.c_str());
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      size_ = static_cast<size_t>(st.st_size);
+      void* p = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED) {
+        base_ = static_cast<const uint8_t*>(p);
+        madvise(p, size_, MADV_SEQUENTIAL);
+      }
+    }
+    close(fd);  // the mapping stays valid
+#endif
+    if (base_ == nullptr) {
+      fprintf(stderr, "Error in mmap %s\n", filename.c_str());
+      Close();
+      return false;
+    }
+    if (!ParseHeader()) {
+      Close();
+      return false;
+    }
+    return true;
+  }
+
+  void Close() {
+#ifdef _WIN32
+    if (base_ != nullptr) UnmapViewOfFile(base_);
+    if (mapping_ != NULL) CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+    mapping_ = NULL;
+    file_ = INVALID_HANDLE_VALUE;
+#else
+    if (base_ != nullptr) munmap(const_cast<uint8_t*>(base_), size_);
+#endif
+    base_ = nullptr;
+    size_ = 0;
+    pcm_ = nullptr;
+    pcm_bytes_ = 0;
+    num_samples_ = 0;
+    format_ = PcmFormat::kUnknown;
+  }
+
+  int num_channel() const { return num_channel_; }
+  int sample_rate() const { return sample_rate_; }
+  int bits_per_sample() const { return bits_per_sample_; }
+  size_t num_samples() const { return num_samples_; }  // per channel
+  PcmFormat format() const { return format_; }
+
+  // Interleaved PCM payload inside the mapping (valid until Close()).
+  const void* pcm_data() const { return pcm_; }
+  size_t pcm_bytes() const { return pcm_bytes_; }
+  // File offset of the payload, for copying byte ranges with file-level calls.
+  size_t pcm_offset() const {
+    return static_cast<size_t>(static_cast<const uint8_t*>(pcm_) - base_);
+  }
+
+  // Typed view of the payload, or nullptr if T does not match format():
+  // uint8_t, int16_t, int32_t or float (24-bit data is only available as bytes).
+  // The data chunk is usually but not necessarily aligned for T.
+  template <typename T>
+  const T* pcm_as() const {
+    return format_ == FormatOf(static_cast<T*>(nullptr))
+               ? static_cast<const T*>(pcm_)
+               : nullptr;
+  }
+
+  // Converts num_frames frames of one channel, starting at frame_offset, into
+  // out as float in [-1, 1). The range must lie within num_samples().
+  void ReadFloat(size_t frame_offset, size_t num_frames, float* out,
+                 int channel = 0) const {
+    const size_t stride = static_cast<size_t>(num_channel_);
+    const size_t first = frame_offset * stride + channel;
+    if (stride == 1) {  // contiguous: SIMD kernels from pcm_convert.h
+      const uint8_t* p = static_cast<const uint8_t*>(pcm_) + first * (bits_per_sample_ / 8);
+      if (!pcm::ToFloat(format_ == PcmFormat::kFloat32 ? 3 : 1, bits_per_sample_, p, out, num_frames))
+        memset(out, 0, num_frames * sizeof(float));
+      return;
+    }
+    switch (format_) {
+      case PcmFormat::kUInt8: {
+        const uint8_t* p = static_cast<const uint8_t*>(pcm_) + first;
+        for (size_t i = 0; i < num_frames; ++i)
+          out[i] = (static_cast<float>(p[i * stride]) - 128.0f) / 128.0f;
+        break;
+      }
+      case PcmFormat::kInt16: {
+        const uint8_t* p = static_cast<const uint8_t*>(pcm_) + first * 2;
+        for (size_t i = 0; i < num_frames; ++i) {
+          int16_t v;
+          memcpy(&v, p + i * stride * 2, sizeof(v));
+          out[i] = static_cast<float>(v) / 32768.0f;
+        }
+        break;
+      }
+      case PcmFormat::kInt24: {
+        const uint8_t* p = static_cast<const uint8_t*>(pcm_) + first * 3;
+        for (size_t i = 0; i < num_frames; ++i) {
+          const uint8_t* b = p + i * stride * 3;
+          int32_t v = static_cast<int32_t>(static_cast<uint32_t>(b[0]) << 8 |
+                                           static_cast<uint32_t>(b[1]) << 16 |
+                                           static_cast<uint32_t>(b[2]) << 24) >> 8;
+          out[i] = static_cast<float>(v) / 8388608.0f;
+        }
+        break;
+      }
+      case PcmFormat::kInt32: {
+        const uint8_t* p = static_cast<const uint8_t*>(pcm_) + first * 4;
+        for (size_t i = 0; i < num_frames; ++i) {
+          int32_t v;
+          memcpy(&v, p + i * stride * 4, sizeof(v));
+          out[i] = static_cast<float>(v) / 2147483648.0f;
+        }
+        break;
+      }
+      case PcmFormat::kFloat32: {
+        const uint8_t* p = static_cast<const uint8_t*>(pcm_) + first * 4;
+        for (size_t i = 0; i < num_frames; ++i)
+          memcpy(&out[i], p + i * stride * 4, sizeof(float));
+        break;
+      }
+      default:
+        memset(out, 0, num_frames * sizeof(float));
+        break;
+    }
+  }
+
+ private:
+  static PcmFormat FormatOf(uint8_t*) { return PcmFormat::kUInt8; }
+  static PcmFormat FormatOf(int16_t*) { return PcmFormat::kInt16; }
+  static PcmFormat FormatOf(int32_t*) { return PcmFormat::kInt32; }
+  static PcmFormat FormatOf(float*) { return PcmFormat::kFloat32; }
+
+  static uint16_t ReadU16(const uint8_t* p) {
+    uint16_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+  }
+  static uint32_t ReadU32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+  }
+
+  // Walks the RIFF chunks, reading "fmt " and locating "data" (other chunks,
+  // e.g. "LIST" or "fact", are skipped).
+  bool ParseHeader() {
+    if (size_ < 12 || memcmp(base_, "RIFF", 4) != 0 ||
+        memcmp(base_ + 8, "WAVE", 4) != 0) {
+      fprintf(stderr, "WaveData: not a RIFF/WAVE file.\n");
+      return false;
+    }
+    uint16_t format_tag = 0;
+    bool has_fmt = false;
+    size_t pos = 12;
+    while (pos + 8 <= size_) {
+      const uint8_t* chunk = base_ + pos;
+      size_t chunk_size = ReadU32(chunk + 4);
+      const uint8_t* body = chunk + 8;
+      if (memcmp(chunk, "fmt ", 4) == 0) {
+        if (chunk_size < 16 || pos + 8 + 16 > size_) {
+          fprintf(stderr, "WaveData: expect PCM format data "
+                         "to have fmt chunk of at least size 16.\n");
+          return false;
+        }
+        format_tag = ReadU16(body);
+        num_channel_ = ReadU16(body + 2);
+        sample_rate_ = static_cast<int>(ReadU32(body + 4));
+        bits_per_sample_ = ReadU16(body + 14);
+        // WAVE_FORMAT_EXTENSIBLE: the real format is the start of the subformat GUID.
+        if (format_tag == 0xFFFE && chunk_size >= 40 && pos + 8 + 26 <= size_)
+          format_tag = ReadU16(body + 24);
+        has_fmt = true;
+      } else if (memcmp(chunk, "data", 4) == 0) {
+        // A size of 0 or one running past the end (streamed files) means "to EOF".
+        size_t available = size_ - (pos + 8);
+        pcm_ = body;
+        pcm_bytes_ = (chunk_size == 0 || chunk_size > available) ? available : chunk_size;
+        break;
+      }
+      pos += 8 + chunk_size + (chunk_size & 1);
+    }
+    if (!has_fmt || pcm_ == nullptr || num_channel_ <= 0) {
+      fprintf(stderr, "WaveData: missing fmt or data chunk.\n");
+      return false;
+    }
+
+    format_ = PcmFormatOf(format_tag, bits_per_sample_);
+    if (format_ == PcmFormat::kUnknown) {
+      fprintf(stderr, "unsupported quantization bits\n");
+      return false;
+    }
+    num_samples_ = pcm_bytes_ / (bits_per_sample_ / 8) / num_channel_;
+    return true;
+  }
+
+#ifdef _WIN32
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+  HANDLE mapping_ = NULL;
+#endif
+  const uint8_t* base_ = nullptr;
+  size_t size_ = 0;
+  const void* pcm_ = nullptr;
+  size_t pcm_bytes_ = 0;
+  int num_channel_ = 0;
+  int sample_rate_ = 0;
+  int bits_per_sample_ = 0;
+  size_t num_samples_ = 0;  // sample points per channel
+  PcmFormat format_ = PcmFormat::kUnknown;
+};
+
+// Streaming WAV reader for arbitrarily long files. The header is parsed with a
+// few small reads; Read() then decodes the next block of frames into a caller
+// buffer. Memory use is one block, whatever the file length.
+class WavStreamReader {
+ public:
+  WavStreamReader() {}
+  explicit WavStreamReader(const std::string& filename) { Open(filename); }
+  ~WavStreamReader() { Close(); }
+
+  WavStreamReader(const WavStreamReader&) = delete;
+  WavStreamReader& operator=(const WavStreamReader&) = delete;
+
+  bool Open(const std::string& filename) {
+    Close();
+    fp_ = fopen(filename.c_str(), "rb");
+    if (NULL == fp_) {
+      fprintf(stderr, "Error in read %s\n", filename.c_str());
+      return false;
+    }
+    if (!ParseHeader()) {
+      Close();
+      return false;
+    }
+    return true;
+  }
+
+  void Close() {
+    if (fp_ != NULL) fclose(fp_);
+    fp_ = NULL;
+    num_samples_ = 0;
+    position_ = 0;
+    format_ = PcmFormat::kUnknown;
+  }
+
+  int num_channel() const { return num_channel_; }
+  int sample_rate() const { return sample_rate_; }
+  int bits_per_sample() const { return bits_per_sample_; }
+  // Per channel. An upper bound if the header leaves the data size open (0).
+  size_t num_samples() const { return num_samples_; }
+  size_t position() const { return position_; }  // frames read so far
+  PcmFormat format() const { return format_; }
+
+  // Decodes up to max_frames of the next frames (one channel) into out as float
+  // in [-1, 1). Returns the number of frames read; 0 at the end of the data.
+  size_t Read(float* out, size_t max_frames, int channel = 0) {
+    if (fp_ == NULL) return 0;
+    size_t frames = std::min(max_frames, num_samples_ - position_);
+    const size_t frame_bytes = static_cast<size_t>(num_channel_) * (bits_per_sample_ / 8);
+    if (raw_.size() < frames * frame_bytes) raw_.resize(frames * frame_bytes);
+    frames = fread(raw_.data(), frame_bytes, frames, fp_);
+    position_ += frames;
+    if (num_channel_ == 1) {
+      pcm::ToFloat(format_ == PcmFormat::kFloat32 ? 3 : 1, bits_per_sample_,
+                   raw_.data(), out, frames);
+      return frames;
+    }
+    // Interleaved: convert the wanted channel one sample at a time.
+    const size_t bytes = bits_per_sample_ / 8;
+    const uint8_t* p = raw_.data() + channel * bytes;
+    for (size_t i = 0; i < frames; ++i, p += frame_bytes)
+      pcm::ToFloat(format_ == PcmFormat::kFloat32 ? 3 : 1, bits_per_sample_, p, out + i, 1);
+    return frames;
+  }
+
+  // Decodes up to max_frames of the next frames of every channel: channel c goes
+  // to out[c], which must hold max_frames floats. The block is converted with
+  // the SIMD kernels and then deinterleaved (pcm::Deinterleave). Returns the
+  // number of frames read; 0 at the end of the data.
+  size_t ReadChannels(float* const* out, size_t max_frames) {
+    if (fp_ == NULL) return 0;
+    size_t frames = std::min(max_frames, num_samples_ - position_);
+    const size_t frame_bytes = static_cast<size_t>(num_channel_) * (bits_per_sample_ / 8);
+    if (raw_.size() < frames * frame_bytes) raw_.resize(frames * frame_bytes);
+    frames = fread(raw_.data(), frame_bytes, frames, fp_);
+    position_ += frames;
+    const size_t n = frames * num_channel_;
+    if (interleaved_.size() < n) interleaved_.resize(n);
+    pcm::ToFloat(format_ == PcmFormat::kFloat32 ? 3 : 1, bits_per_sample_,
+                 raw_.data(), interleaved_.data(), n);
+    pcm::Deinterleave(interleaved_.data(), num_channel_, out, frames);
+    return frames;
+  }
+
+ private:
+  bool ParseHeader() {
+    uint8_t riff[12];
+    if (fread(riff, 1, 12, fp_) != 12 || memcmp(riff, "RIFF", 4) != 0 ||
+        memcmp(riff + 8, "WAVE", 4) != 0) {
+      fprintf(stderr, "WaveData: not a RIFF/WAVE file.\n");
+      return false;
+    }
+    int format_tag = 0;
+    bool has_fmt = false;
+    uint8_t chunk[8];
+    while (fread(chunk, 1, 8, fp_) == 8) {
+      uint32_t chunk_size;
+      memcpy(&chunk_size, chunk + 4, sizeof(chunk_size));
+      if (memcmp(chunk, "fmt ", 4) == 0) {
+        uint8_t fmt[40] = {0};
+        size_t n = std::min<size_t>(chunk_size, sizeof(fmt));
+        if (chunk_size < 16 || fread(fmt, 1, n, fp_) != n) {
+          fprintf(stderr, "WaveData: expect PCM format data "
+                         "to have fmt chunk of at least size 16.\n");
+          return false;
+        }
+        uint16_t tag, channels, bits;
+        uint32_t rate;
+        memcpy(&tag, fmt, 2);
+        memcpy(&channels, fmt + 2, 2);
+        memcpy(&rate, fmt + 4, 4);
+        memcpy(&bits, fmt + 14, 2);
+        if (tag == 0xFFFE && chunk_size >= 40) memcpy(&tag, fmt + 24, 2);
+        format_tag = tag;
+        num_channel_ = channels;
+        sample_rate_ = static_cast<int>(rate);
+        bits_per_sample_ = bits;
+        has_fmt = true;
+        fseek(fp_, static_cast<long>(chunk_size - n + (chunk_size & 1)), SEEK_CUR);
+      } else if (memcmp(chunk, "data", 4) == 0) {
+        if (!has_fmt || num_channel_ <= 0) break;
+        format_ = PcmFormatOf(format_tag, bits_per_sample_);
+        if (format_ == PcmFormat::kUnknown) {
+          fprintf(stderr, "unsupported quantization bits\n");
+          return false;
+        }
+        // A size of 0 (streamed files) means "to EOF"; the last Read() stops short.
+        uint64_t data_bytes = chunk_size != 0 ? chunk_size : UINT32_MAX;
+        num_samples_ = static_cast<size_t>(
+            data_bytes / (bits_per_sample_ / 8) / num_channel_);
+        return true;
+      } else {
+        fseek(fp_, static_cast<long>(chunk_size + (chunk_size & 1)), SEEK_CUR);
+      }
+    }
+    fprintf(stderr, "WaveData: missing fmt or data chunk.\n");
+    return false;
+  }
+
+  FILE* fp_ = NULL;
+  std::vector<uint8_t> raw_;  // one block of raw PCM bytes
+  std::vector<float> interleaved_;  // ReadChannels(): the block as float
+  int num_channel_ = 0;
+  int sample_rate_ = 0;
+  int bits_per_sample_ = 0;
+  size_t num_samples_ = 0;  // sample points per channel
+  size_t position_ = 0;
+  PcmFormat format_ = PcmFormat::kUnknown;
 };
 
 class WavWriter {
@@ -6,6 +6,9 @@
 
 #include "silero_torch.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace silero {
 
 	VadIterator::VadIterator(const std::string &model_path, float threshold, int sample_rate, int window_size_ms, int speech_pad_ms, int min_silence_duration_ms, int min_speech_duration_ms, int max_duration_merge_ms, bool print_as_samples)
@@ -19,133 +22,103 @@ namespace silero {
 
 
 	void VadIterator::SpeechProbs(std::vector<float>& input_wav){
-		// Set the sample rate (must match the model's expected sample rate)
-		// Process the waveform in chunks of 512 samples
-		int num_samples = input_wav.size();
-		int num_chunks = num_samples / window_size_samples;
-		int remainder_samples = num_samples % window_size_samples;
-
-		total_sample_size += num_samples;
-
-		torch::Tensor output;
-		std::vector<torch::Tensor> chunks;
-
-		for (int i = 0; i < num_chunks; i++) {
-
-			float* chunk_start = input_wav.data() + i *window_size_samples;
-			torch::Tensor chunk = torch::from_blob(chunk_start, {1,window_size_samples}, torch::kFloat32);
-			//std::cout<<"chunk size : "<<chunk.sizes()<<std::endl;
-			chunks.push_back(chunk);
-
-
-			if(i==num_chunks-1 && remainder_samples>0){//마지막 chunk && 나머지가 존재
-				int remaining_samples = num_samples - num_chunks * window_size_samples;
-				//std::cout<<"Remainder size : "<<remaining_samples;
-				float* chunk_start_remainder = input_wav.data() + num_chunks *window_size_samples;
-
-				torch::Tensor remainder_chunk = torch::from_blob(chunk_start_remainder, {1,remaining_samples},
-						torch::kFloat32);
-				// Pad the remainder chunk to match window_size_samples
-				torch::Tensor padded_chunk = torch::cat({remainder_chunk, torch::zeros({1, window_size_samples
-							- remaining_samples}, torch::kFloat32)}, 1);
-				//std::cout<<", padded_chunk size : "<<padded_chunk.size(1)<<std::endl;
-
-				chunks.push_back(padded_chunk);
-			}
+		// Process the waveform in windows of window_size_samples (512 at 16kHz). A partial
+		// last window is carried over to the next call, so chunks of any size give the same
+		// windows, and the same timestamps, as one call with the whole stream.
+		if (inputs.empty())
+			init_engine(window_size_ms);
+		total_sample_size += input_wav.size();
+
+		std::vector<float>* audio = &input_wav;
+		if (!carry.empty()) {
+			carry.insert(carry.end(), input_wav.begin(), input_wav.end());
+			audio = &carry;
 		}
+		const int num_chunks = audio->size() / window_size_samples;
+		if (num_chunks > 0)
+			ProcessWindows(audio->data(), num_chunks);
+
+		const size_t used = static_cast<size_t>(num_chunks) * window_size_samples;
+		if (audio == &carry)
+			carry.erase(carry.begin(), carry.begin() + used);
+		else
+			carry.assign(input_wav.begin() + used, input_wav.end());
+	}
 
-		if (!chunks.empty()) {
+	// Runs the model over rows whole windows starting at samples.
+	void VadIterator::ProcessWindows(float* samples, int rows) {
+		torch::NoGradGuard no_grad;
 
 #ifdef USE_BATCH
-			torch::Tensor batched_chunks = torch::stack(chunks);  // Stack all chunks into a single tensor
-			//batched_chunks = batched_chunks.squeeze(1);
-			batched_chunks = torch::cat({batched_chunks.squeeze(1)});
-
+		inputs[0] = torch::from_blob(samples, {rows, window_size_samples}, torch::kFloat32);  // Batch of chunks
 #ifdef USE_GPU
-			batched_chunks = batched_chunks.to(at::kCUDA);        // Move the entire batch to GPU once
+		inputs[0] = inputs[0].toTensor().to(at::kCUDA);  // Move the entire batch to GPU once
 #endif
-			// Prepare input for model
-			std::vector<torch::jit::IValue> inputs;
-			inputs.push_back(batched_chunks);  // Batch of chunks
-			inputs.push_back(sample_rate);     // Assuming sample_rate is a valid input for the model
-
-			// Run inference on the batch
-			torch::NoGradGuard no_grad;
-			torch::Tensor output = model.forward(inputs).toTensor();
+		torch::Tensor output = model.forward(inputs).toTensor();
 #ifdef USE_GPU
-			output = output.to(at::kCPU);      // Move the output back to CPU once
+		output = output.to(at::kCPU);      // Move the output back to CPU once
 #endif
-			// Collect output probabilities
-			for (int i = 0; i < chunks.size(); i++) {
-				float output_f = output[i].item<float>();
-				outputs_prob.push_back(output_f);
-				//std::cout << "Chunk " << i << " prob: " << output_f<< "\n";
-			}
+		output = output.contiguous();
+		const float* probs = output.data_ptr<float>();
+		for (int i = 0; i < rows; i++)
+			DoVad(probs[i]);
+		inputs[0] = window_tensor;  // don't keep a view of the caller's buffer
+#elif defined(USE_GPU)
+		// The audio goes to the GPU once and every window is a view into it. The
+		// probabilities stay on the device until one copy back at the end, so the
+		// loop never waits for the GPU.
+		torch::Tensor audio = torch::from_blob(samples, {rows, window_size_samples}, torch::kFloat32).to(at::kCUDA);
+		torch::Tensor probs = torch::empty({rows, 1}, audio.options());
+		for (int i = 0; i < rows; i++) {
+			inputs[0] = audio.narrow(0, i, 1);
+			probs.narrow(0, i, 1).copy_(model.forward(inputs).toTensor());
+		}
+		inputs[0] = window_tensor;
+		probs = probs.to(at::kCPU);
+		for (int i = 0; i < rows; i++)
+			DoVad(probs.data_ptr<float>()[i]);
 #else
-
-			std::vector<torch::Tensor> outputs;
-			torch::Tensor batched_chunks = torch::stack(chunks);
-#ifdef USE_GPU
-			batched_chunks = batched_chunks.to(at::kCUDA);
-#endif
-			for (int i = 0; i < chunks.size(); i++) {
-				torch::NoGradGuard no_grad;
-				std::vector<torch::jit::IValue> inputs;
-				inputs.push_back(batched_chunks[i]);
-				inputs.push_back(sample_rate);
-
-				torch::Tensor output = model.forward(inputs).toTensor();
-				outputs.push_back(output);
-			}
-			torch::Tensor all_outputs = torch::stack(outputs);
-#ifdef USE_GPU
-			all_outputs = all_outputs.to(at::kCPU);
-#endif
-			for (int i = 0; i < chunks.size(); i++) {
-				float output_f = all_outputs[i].item<float>();
-				outputs_prob.push_back(output_f);
-			}
-
-
-
-#endif
-
+		// Each window is copied into the reused input tensor (2KB); the model concatenates
+		// its context in front of it, so it never keeps a reference to this buffer. The
+		// [1,1] output is read in place.
+		float* window = window_tensor.data_ptr<float>();
+		for (int i = 0; i < rows; i++) {
+			std::memcpy(window, samples + static_cast<size_t>(i) * window_size_samples, window_size_samples * sizeof(float));
+			DoVad(model.forward(inputs).toTensor().data_ptr<float>()[0]);
 		}
-
-
+#endif
 	}
 
 
 	std::vector<SpeechSegment> VadIterator::GetSpeechTimestamps() {
-		std::vector<SpeechSegment> speeches = DoVad();
-
-#ifdef USE_BATCH
-		//When you use BATCH inference. You would better use 'mergeSpeeches' function to arrage time stamp.
-		//It could be better get reasonable output because of distorted probs.
-		duration_merge_samples = sample_rate * max_duration_merge_ms / 1000;
-		std::vector<SpeechSegment> speeches_merge = mergeSpeeches(speeches, duration_merge_samples);
-		if(!print_as_samples){
-			for (auto& speech : speeches_merge) { //samples to second
-				speech.start /= sample_rate;
-				speech.end /= sample_rate;
-			}
+		// End of input: the carried partial window runs zero-padded (a stream shorter than
+		// one window is ignored), then the open segment closes at the last sample.
+		if (!carry.empty() && current_sample > 0) {
+			carry.resize(window_size_samples, 0.0f);
+			ProcessWindows(carry.data(), 1);
 		}
-
-		return speeches_merge;
-#else
-
-		if(!print_as_samples){
-			for (auto& speech : speeches) { //samples to second
-				speech.start /= sample_rate;
-				speech.end /= sample_rate;
-			}
+		carry.clear();
+		if (triggered) {
+			std::cout<<"when last triggered is keep working until last Probs"<<std::endl;
+			current.end = total_sample_size;
+			triggered = false;
+			EndSegment(current);
+		}
+		if (has_pending) {
+			Emit(pending);
+			has_pending = false;
 		}
 
-		return speeches;
-
-#endif
+		std::vector<SpeechSegment> result;
+		result.swap(speeches);
+		reset_states();
+		return result;
+	}
 
+	void VadIterator::SetSegmentCallback(std::function<void(const SpeechSegment&)> callback) {
+		on_segment = std::move(callback);
 	}
+
 	void VadIterator::SetVariables(){
 		init_engine(window_size_ms);
 	}
@@ -155,6 +128,12 @@ namespace silero {
 		speech_pad_samples = sample_rate * speech_pad_ms / 1000;
 		window_size_samples = sample_rate / 1000 * window_size_ms;
 		min_speech_samples = sample_rate * min_speech_duration_ms / 1000;
+		duration_merge_samples = sample_rate * max_duration_merge_ms / 1000;
+
+		window_tensor = torch::zeros({1, window_size_samples}, torch::kFloat32);
+		inputs.clear();
+		inputs.push_back(window_tensor);
+		inputs.push_back(sample_rate);
 	}
 
 	void VadIterator::init_torch_model(const std::string& model_path) {
@@ -183,103 +162,74 @@ namespace silero {
 		triggered = false;
 		current_sample = 0;
 		temp_end = 0;
-		outputs_prob.clear();
+		has_pending = false;
 		model.run_method("reset_states");
 		total_sample_size = 0;
+		carry.clear();
 	}
 
-	std::vector<SpeechSegment> VadIterator::DoVad() {
-		std::vector<SpeechSegment> speeches;
+	// One step of the hysteresis state machine, run as each probability comes out of the
+	// model. Only the open segment is kept, so memory does not grow with the input.
+	void VadIterator::DoVad(float speech_prob) {
+		current_sample += window_size_samples;
 
-		for (size_t i = 0; i < outputs_prob.size(); ++i) {
-			float speech_prob = outputs_prob[i];
-			//std::cout << speech_prob << std::endl;
-			//std::cout << "Chunk " << i << " Prob: " << speech_prob << "\n";
-			//std::cout << speech_prob << " ";
-			current_sample += window_size_samples;
+		if (speech_prob >= threshold && temp_end != 0) {
+			temp_end = 0;
+		}
 
-			if (speech_prob >= threshold && temp_end != 0) {
-				temp_end = 0;
-			}
+		if (speech_prob >= threshold && !triggered) {
+			triggered = true;
+			current.start = std::max<int64_t>(0, current_sample - speech_pad_samples - window_size_samples);
+			current.end = 0;
+			return;
+		}
 
-			if (speech_prob >= threshold && !triggered) {
-				triggered = true;
-				SpeechSegment segment;
-				segment.start = std::max(static_cast<int>(0), current_sample - speech_pad_samples - window_size_samples);
-				speeches.push_back(segment);
-				continue;
+		if (speech_prob < threshold - 0.15f && triggered) {
+			if (temp_end == 0) {
+				temp_end = current_sample;
 			}
 
-			if (speech_prob < threshold - 0.15f && triggered) {
-				if (temp_end == 0) {
-					temp_end = current_sample;
-				}
-
-				if (current_sample - temp_end < min_silence_samples) {
-					continue;
-				} else {
-					SpeechSegment& segment = speeches.back();
-					segment.end = temp_end + speech_pad_samples - window_size_samples;
-					temp_end = 0;
-					triggered = false;
-				}
+			if (current_sample - temp_end >= min_silence_samples) {
+				current.end = temp_end + speech_pad_samples - window_size_samples;
+				temp_end = 0;
+				triggered = false;
+				EndSegment(current);
 			}
 		}
-
-		if (triggered) { //만약 낮은 확률을 보이다가  마지막프레임 prbos만 딱 확률이 높게 나오면 위에서 triggerd = true 메핑과 동시에  segment start가 돼서 문제가 될것 같은데? start = end 같은값? 후처리가 있으니 문제가 없으려나?
-			std::cout<<"when last triggered is keep working until last Probs"<<std::endl;
-			SpeechSegment& segment = speeches.back();
-			segment.end = total_sample_size;  // 현재 샘플을 마지막 구간의 종료 시간으로 설정
-			triggered = false;  // VAD 상태 초기화
-		}
-
-		speeches.erase(
-                		std::remove_if(
-                        speeches.begin(),
-                        speeches.end(),
-                        [this](const SpeechSegment& speech) {
-                        return ((speech.end - this->speech_pad_samples) - (speech.start + this->speech_pad_samples) < min_speech_samples);
-			//min_speech_samples is 4000samples(0.25sec)
-			//여기서 포인트!! 계산 할때는 start,end sample에'speech_pad_samples' 사이즈를 추가한후 길이를 측정함. 
-                        }
-                ),
-                speeches.end()
-              );
-
-
-		//std::cout<<std::endl;
-		//std::cout<<"outputs_prob.size : "<<outputs_prob.size()<<std::endl;
-
-		reset_states();
-		return speeches;
 	}
 
-	std::vector<SpeechSegment> VadIterator::mergeSpeeches(const std::vector<SpeechSegment>& speeches, int duration_merge_samples) {
-		std::vector<SpeechSegment> mergedSpeeches;
-
-		if (speeches.empty()) {
-			return mergedSpeeches; // 빈 벡터 반환
+	// A closed segment: drop it if it is too short, otherwise pass it on.
+	void VadIterator::EndSegment(const SpeechSegment& segment) {
+		//min_speech_samples is 4000samples(0.25sec)
+		//여기서 포인트!! 계산 할때는 start,end sample에'speech_pad_samples' 사이즈를 추가한후 길이를 측정함. 
+		if ((segment.end - speech_pad_samples) - (segment.start + speech_pad_samples) < min_speech_samples)
+			return;
+#ifdef USE_BATCH
+		//When you use BATCH inference, segments closer than duration_merge_samples are merged,
+		//because batched probs are distorted. The last segment is held until the next one
+		//shows whether it extends it.
+		if (has_pending && segment.start - pending.end < duration_merge_samples) {
+			pending.end = segment.end;
+			return;
 		}
+		if (has_pending)
+			Emit(pending);
+		pending = segment;
+		has_pending = true;
+#else
+		Emit(segment);
+#endif
+	}
 
-		// 첫 번째 구간으로 초기화
-		SpeechSegment currentSegment = speeches[0];
-
-		for (size_t i = 1; i < speeches.size(); ++i) {	//첫번째 start,end 정보 건너뛰기. 그래서 i=1부터
-			// 두 구간의 차이가 threshold(duration_merge_samples)보다 작은 경우, 합침
-			if (speeches[i].start - currentSegment.end < duration_merge_samples) {
-				// 현재 구간의 끝점을 업데이트
-				currentSegment.end = speeches[i].end;
-			} else {
-				// 차이가 threshold(duration_merge_samples) 이상이면 현재 구간을 저장하고 새로운 구간 시작
-				mergedSpeeches.push_back(currentSegment);
-				currentSegment = speeches[i];
-			}
+	void VadIterator::Emit(SpeechSegment segment) {
+		if(!print_as_samples){ //samples to second
+			segment.start /= sample_rate;
+			segment.end /= sample_rate;
 		}
-
-		// 마지막 구간 추가
-		mergedSpeeches.push_back(currentSegment);
-
-		return mergedSpeeches;
+		if (on_segment)
+			on_segment(segment);
+		else
+			speeches.push_back(segment);
 	}
 
 	}
@@ -6,6 +6,7 @@
 #ifndef SILERO_TORCH_H
 #define SILERO_TORCH_H
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <stdexcept>
@@ -14,6 +15,7 @@
 #include <vector>
 #include <fstream>
 #include <chrono>
+#include <functional>
 
 #include <torch/torch.h>
 #include <torch/script.h>
@@ -21,9 +23,11 @@
 
 namespace silero{
 
+	// In samples (seconds when !print_as_samples). 64-bit: a stream fed through
+	// repeated SpeechProbs calls passes 2^31 samples after about 37 hours at 16kHz.
 	struct SpeechSegment{
-		int start;
-		int end;
+		int64_t start;
+		int64_t end;
 	};
 
 	class VadIterator{
@@ -35,8 +39,17 @@ namespace silero{
 			~VadIterator(); 
 
 
+			// Runs the model over input_wav and the segment state machine over its
+			// probabilities. Can be called repeatedly with consecutive parts of a stream,
+			// of any size: samples short of a whole window wait for the next call.
 			void SpeechProbs(std::vector<float>& input_wav);
+			// Ends the stream (a leftover partial window runs zero-padded) and returns the
+			// segments not passed to a callback, then resets the iterator for the next stream.
 			std::vector<silero::SpeechSegment> GetSpeechTimestamps();
+			// Receives each segment as soon as it is final (after min-speech filtering,
+			// and merging with USE_BATCH) instead of collecting it. Memory then stays
+			// constant however long the stream is.
+			void SetSegmentCallback(std::function<void(const SpeechSegment&)> callback);
 			void SetVariables();
 
 			float threshold;
@@ -48,26 +61,37 @@ namespace silero{
 
 		private:
 			torch::jit::script::Module model;
-			std::vector<float> outputs_prob;
 			int min_silence_samples;
 			int min_speech_samples;
 			int speech_pad_samples;
 			int window_size_samples;
 			int duration_merge_samples;
-			int current_sample = 0;
+			int64_t current_sample = 0;
 
-			int total_sample_size=0;
+			int64_t total_sample_size=0;
 
 			int min_silence_duration_ms;
 			int speech_pad_ms;
 			bool triggered = false;
-			int temp_end = 0;
+			int64_t temp_end = 0;
+			SpeechSegment current;              // open segment while triggered
+			SpeechSegment pending;              // last segment, held for merging (USE_BATCH)
+			bool has_pending = false;
+			std::vector<SpeechSegment> speeches;  // finished segments when there is no callback
+			std::function<void(const SpeechSegment&)> on_segment;
+
+			// Model input reused for every window: {window_tensor, sample_rate}.
+			torch::Tensor window_tensor;
+			std::vector<torch::jit::IValue> inputs;
+			std::vector<float> carry;           // samples of an incomplete window from the last call
 
 			void init_engine(int window_size_ms);
+			void ProcessWindows(float* samples, int rows);
 			void init_torch_model(const std::string& model_path);
 			void reset_states();
-			std::vector<SpeechSegment> DoVad();
-			std::vector<SpeechSegment> mergeSpeeches(const std::vector<SpeechSegment>& speeches, int duration_merge_samples);
+			void DoVad(float speech_prob);
+			void EndSegment(const SpeechSegment& segment);
+			void Emit(SpeechSegment segment);
 
 	};
 
@@ -0,0 +1,88 @@
+//Description : batched inference across independent streams for torch-script(c++).
+
+
+#include "silero_torch_batch.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace silero {
+
+	BatchedVad::BatchedVad(const std::string &model_path, int num_streams, int sample_rate)
+		:num_streams(num_streams), sample_rate(sample_rate)
+	{
+		if (num_streams <= 0)
+			throw std::invalid_argument("BatchedVad: num_streams must be positive");
+		if (sample_rate != 16000 && sample_rate != 8000)
+			throw std::invalid_argument("BatchedVad: sample rate must be 8000 or 16000");
+
+		at::set_num_threads(1);
+		model = torch::jit::load(model_path);
+		model.eval();
+		// The merged model keeps one network per sample rate; it takes the window with its
+		// context in front and an explicit state, and returns the new state.
+		net = model.attr(sample_rate == 16000 ? "_model" : "_model_8k").toModule();
+#ifdef USE_GPU
+		if (!torch::cuda::is_available())
+			throw std::runtime_error("CUDA is not available!");
+		net.to(at::Device(at::kCUDA, 0));
+#endif
+
+		window_size_samples = sample_rate == 16000 ? 512 : 256;
+		context_samples = net.attr("context_size_samples").toInt();
+		input = torch::zeros({num_streams, context_samples + window_size_samples}, torch::kFloat32);
+		Reset();
+	}
+
+	void BatchedVad::Reset() {
+		input.zero_();
+		state = torch::zeros({2, num_streams, 128}, torch::kFloat32);
+#ifdef USE_GPU
+		state = state.to(at::kCUDA);
+#endif
+		inputs.clear();
+		inputs.push_back(input);
+		inputs.push_back(state);
+	}
+
+	void BatchedVad::ResetStream(int stream) {
+		if (stream < 0 || stream >= num_streams)
+			throw std::out_of_range("BatchedVad: stream index out of range");
+		input[stream].zero_();
+		state.select(1, stream).zero_();
+	}
+
+	void BatchedVad::Process(const float* windows, float* probs) {
+		const int row = context_samples + window_size_samples;
+		float* rows = input.data_ptr<float>();
+		for (int s = 0; s < num_streams; s++) {
+			// The context is the tail of the stream's previous window.
+			float* r = rows + static_cast<size_t>(s) * row;
+			std::memmove(r, r + window_size_samples, context_samples * sizeof(float));
+			std::memcpy(r + context_samples, windows + static_cast<size_t>(s) * window_size_samples,
+				window_size_samples * sizeof(float));
+		}
+
+		torch::NoGradGuard no_grad;
+#ifdef USE_GPU
+		inputs[0] = input.to(at::kCUDA);
+#endif
+		auto outputs = net.forward(inputs).toTuple();
+		state = outputs->elements()[1].toTensor();
+		inputs[1] = state;
+		torch::Tensor out = outputs->elements()[0].toTensor();   // [num_streams, 1]
+#ifdef USE_GPU
+		out = out.to(at::kCPU);
+#endif
+		out = out.contiguous();
+		std::memcpy(probs, out.data_ptr<float>(), num_streams * sizeof(float));
+	}
+
+	void BatchedVad::Process(const std::vector<float>& windows, std::vector<float>& probs) {
+		if (windows.size() != static_cast<size_t>(num_streams) * window_size_samples)
+			throw std::invalid_argument("BatchedVad: expected num_streams * WindowSize() samples");
+		probs.resize(num_streams);
+		Process(windows.data(), probs.data());
+	}
+
+}
@@ -0,0 +1,57 @@
+//Description : batched inference across independent streams for torch-script(c++).
+
+#ifndef SILERO_TORCH_BATCH_H
+#define SILERO_TORCH_BATCH_H
+
+#include <string>
+#include <vector>
+
+#include <torch/torch.h>
+#include <torch/script.h>
+
+
+namespace silero{
+
+	// Runs the current window of num_streams independent streams in one forward call.
+	//
+	// Unlike USE_BATCH, which batches consecutive windows of one file, every row of the
+	// batch is a different stream, so each stream's LSTM state carries over from its own
+	// previous window. That state is an explicit [2, num_streams, 128] tensor passed to the
+	// model's inner network, not the module cache managed by reset_states(). The context
+	// samples in front of each window are kept per stream as well, so every stream gets the
+	// same probabilities as processing it alone in silero::VadIterator.
+	class BatchedVad{
+		public:
+
+			BatchedVad(const std::string &model_path, int num_streams, int sample_rate = 16000);
+
+			// windows: num_streams rows of WindowSize() samples, row-major.
+			// probs: receives num_streams speech probabilities, one per row.
+			void Process(const float* windows, float* probs);
+			void Process(const std::vector<float>& windows, std::vector<float>& probs);
+
+			// Clears the state of every stream, or of one stream so its slot can start a
+			// new recording while the others continue.
+			void Reset();
+			void ResetStream(int stream);
+
+			int NumStreams() const { return num_streams; }
+			int WindowSize() const { return window_size_samples; }
+
+		private:
+			torch::jit::script::Module model;
+			torch::jit::script::Module net;   // _model (16kHz) or _model_8k of the merged model
+			int num_streams;
+			int sample_rate;
+			int window_size_samples;
+			int context_samples;
+
+			// [num_streams, context_samples + window_size_samples]: each row is the stream's
+			// context followed by its current window.
+			torch::Tensor input;
+			torch::Tensor state;                    // [2, num_streams, 128] LSTM (h, c)
+			std::vector<torch::jit::IValue> inputs; // {input, state}, reused
+	};
+
+}
+#endif // SILERO_TORCH_BATCH_H
@@ -22,7 +22,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <string>
+#include <vector>
+
+#include "../cpp/pcm_convert.h"  // shared with the ONNX Runtime example
 
 // #include "utils/log.h"
 
@@ -46,7 +50,7 @@ struct WavHeader {
 
 class WavReader {
  public:
-  WavReader() : data_(nullptr) {}
+  WavReader() {}
   explicit WavReader(const std::string& filename) { Open(filename); }
 
   bool Open(const std::string& filename) {
@@ -99,50 +103,24 @@ class WavReader {
     std::cout << "num_samples     :" << num_data << std::endl;
     std::cout << "num_data_size   :" << header.data_size << std::endl;
 
-    switch (bits_per_sample_) {
-        case 8: {
-            char sample;
-            for (int i = 0; i < num_data; ++i) {
-                fread(&sample, 1, sizeof(char), fp);
-                data_[i] = static_cast<float>(sample) / 32768;
-            }
-            break;
-        }
-        case 16: {
-            int16_t sample;
-            for (int i = 0; i < num_data; ++i) {
-                fread(&sample, 1, sizeof(int16_t), fp);
-                data_[i] = static_cast<float>(sample) / 32768;
-            }
-            break;
-        }
-        case 32:
-        {
-            if (header.format == 1) //S32
-            {
-                int sample;
-                for (int i = 0; i < num_data; ++i) {
-                    fread(&sample, 1, sizeof(int), fp);
-                    data_[i] = static_cast<float>(sample) / 32768;
-                }
-            }
-            else if (header.format == 3) // IEEE-float
-            {
-                float sample;
-                for (int i = 0; i < num_data; ++i) {
-                    fread(&sample, 1, sizeof(float), fp);
-                    data_[i] = static_cast<float>(sample);
-                }
-            }
-            else {
-                printf("unsupported quantization bits\n");
-            }
-            break;
-        }
-        default:
-            printf("unsupported quantization bits\n");
-            break;
+    // Read the payload in blocks and convert each block with the SIMD kernels
+    // (pcm_convert.h) instead of one fread per sample.
+    const int bytes_per_sample = bits_per_sample_ / 8;
+    const int kBlockSamples = 16384;
+    std::vector<char> block(static_cast<size_t>(kBlockSamples) * bytes_per_sample);
+    int done = 0;
+    while (done < num_data) {
+      int n = std::min(kBlockSamples, num_data - done);
+      int got = static_cast<int>(fread(block.data(), bytes_per_sample, n, fp));
+      if (!pcm::ToFloat(header.format, bits_per_sample_, block.data(),
+                        data_ + done, got)) {
+        printf("unsupported quantization bits\n");
+        break;
+      }
+      done += got;
+      if (got < n) break;
     }
+    for (; done < num_data; ++done) data_[done] = 0.0f;  // truncated file
 
     fclose(fp);
     return true;
@@ -160,11 +138,12 @@ class WavReader {
   const float* data() const { return data_; }
 
  private:
-  int num_channel_;
-  int sample_rate_;
-  int bits_per_sample_;
-  int num_samples_;  // sample points per channel
-  float* data_;
+  // Zero (no data) until Open() succeeds.
+  int num_channel_ = 0;
+  int sample_rate_ = 0;
+  int bits_per_sample_ = 0;
+  int num_samples_ = 0;  // sample points per channel
+  float* data_ = nullptr;
 };
 
 class WavWriter {